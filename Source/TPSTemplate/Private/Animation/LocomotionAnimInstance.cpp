@@ -5,6 +5,13 @@
 #include "Characters/TPSTemplateCharacter.h"
 #include "Characters/Player_Base.h"
 #include "Components/EquipmentSystem.h"
+#include "TPSTemplate.h"
+
+DECLARE_CYCLE_STAT(TEXT("Locomotion Gather (GT)"), STAT_LocomotionGather, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("Locomotion Update"), STAT_LocomotionUpdate, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Updates"), STAT_LocomotionUpdates, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Updates Skipped (URO)"), STAT_LocomotionUpdatesSkipped, STATGROUP_TPSTemplate);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Locomotion Time Saved (ms)"), STAT_LocomotionTimeSaved, STATGROUP_TPSTemplate);
 
 void ULocomotionAnimInstance::NativeInitializeAnimation()
 {
@@ -25,59 +32,119 @@ void ULocomotionAnimInstance::NativeInitializeAnimation()
 
 void ULocomotionAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+    SCOPE_CYCLE_COUNTER(STAT_LocomotionGather);
+
     Super::NativeUpdateAnimation(DeltaSeconds);
 
     if (!IsValid())
         return;
 
+    // Frames URO skipped since the last update did not pay for the locomotion logic
+    if (LastUpdateFrame != 0 && GFrameCounter > LastUpdateFrame + 1)
+    {
+        const uint64 SkippedFrames = GFrameCounter - LastUpdateFrame - 1;
+        INC_DWORD_STAT_BY(STAT_LocomotionUpdatesSkipped, SkippedFrames);
+        INC_FLOAT_STAT_BY(STAT_LocomotionTimeSaved, static_cast<float>(SkippedFrames * AverageUpdateSeconds * 1000.0));
+    }
+    LastUpdateFrame = GFrameCounter;
+
+    // Movement speed is game-thread state; it follows the wall result of the previous update
+    RunningIntoWall();
+
+    GatherSnapshot();
+}
+
+void ULocomotionAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_LocomotionUpdate);
+    INC_DWORD_STAT(STAT_LocomotionUpdates);
+
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+    if (!IsValid())
+        return;
+
+    const double StartTime = FPlatformTime::Seconds();
+    UpdateDeltaSeconds = DeltaSeconds;
+
     UpdateCharacterState();
     /*
         Set velocity and ground speed from the movement components velocity.
         Ground speed is calculated from only the X and Y axis of the velocity,
         so moving up or down does not affect it.
     */
-    Velocity = MovementComponent->Velocity;
+    Velocity = Snapshot.Velocity;
     GroundSpeed = FVector2D(Velocity.X, Velocity.Y).Length();
     /*
         Set Should Move to true only if ground speed is above a small threshold
         (to prevent incredibly small velocities from triggering animations) and
         if there is currently acceleration (input) applied.
     */
-    Acceleration = MovementComponent->GetCurrentAcceleration();
+    Acceleration = Snapshot.Acceleration;
     bShouldMove = (GroundSpeed > 3.0f) && (Acceleration != FVector(0.0f, 0.0f, 0.0f));
     /*
         Set Is Falling from the movement components falling state.
     */
-    bIsFalling = MovementComponent->IsFalling();
+    bIsFalling = Snapshot.bIsFalling;
 
     // Sequence 4
     UpdateLocomotionDirection();
+
+    // Running average of one update, used to price the frames URO skips
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    AverageUpdateSeconds = AverageUpdateSeconds == 0.0 ? Elapsed : FMath::Lerp(AverageUpdateSeconds, Elapsed, 0.1);
+}
+
+void ULocomotionAnimInstance::GatherSnapshot()
+{
+    Snapshot.Velocity = MovementComponent->Velocity;
+    Snapshot.Acceleration = MovementComponent->GetCurrentAcceleration();
+    Snapshot.bIsFalling = MovementComponent->IsFalling();
+    Snapshot.ActorRotation = CharacterRef->GetActorRotation();
+    Snapshot.ActorVelocity = CharacterRef->GetVelocity();
+    Snapshot.AnimationState = CharacterRef->CurrentAnimationState;
+
+    // Player-specific properties need to be accessed from APlayer_Base
+    const APlayer_Base* PlayerRef = Cast<APlayer_Base>(CharacterRef);
+    Snapshot.bIsPlayer = PlayerRef != nullptr;
+    if (PlayerRef)
+    {
+        Snapshot.bIsPistolEquip = PlayerRef->GetCurWeaponSlot() == EEquipmentSlot::Handgun;
+        Snapshot.bIsRifleEquip = PlayerRef->GetCurWeaponSlot() == EEquipmentSlot::Primary;
+        Snapshot.bIsCrouching = PlayerRef->IsCrouch;
+        Snapshot.bIsSprint = PlayerRef->IsSprint;
+        Snapshot.LandState = PlayerRef->CurrentLandState;
+        Snapshot.bIsJump = PlayerRef->IsJump;
+        Snapshot.bIsAim = PlayerRef->bIsAim;
+        Snapshot.Pitch = (PlayerRef->GetBaseAimRotation() - PlayerRef->GetActorRotation()).GetNormalized().Pitch;
+        Snapshot.TurnRate = PlayerRef->TurnRate;
+    }
+
+    // TODO: Curve Name?
+    Snapshot.IsTurnCurve = GetCurveValue(FName("IsTurn"));
+    Snapshot.DistanceCurve = GetCurveValue(FName("DistanceCurve"));
 }
 
 void ULocomotionAnimInstance::UpdateCharacterState()
 {
     UpdateAcceleration();
     UpdateWallDetection();
-    RunningIntoWall();
 
-    // Player-specific properties need to be accessed from APlayer_Base
-    if (APlayer_Base* PlayerRef = Cast<APlayer_Base>(CharacterRef))
+    if (Snapshot.bIsPlayer)
     {
-        bool bIsPistolEquipped = PlayerRef->GetCurWeaponSlot() == EEquipmentSlot::Handgun;
-        bool bIsPrimaryEquipped = PlayerRef->GetCurWeaponSlot() == EEquipmentSlot::Primary;
-        bIsCrouching = PlayerRef->IsCrouch;
-        bIsSprint = PlayerRef->IsSprint;
-        LandState = PlayerRef->CurrentLandState;
-        bIsJump = PlayerRef->IsJump;
-        bIsAim = PlayerRef->bIsAim;
-        Pitch = (PlayerRef->GetBaseAimRotation() - PlayerRef->GetActorRotation()).GetNormalized().Pitch;
-        bIsPistolEquip = bIsPistolEquipped;
-        bIsRifleEquip = bIsPrimaryEquipped;
-        DirectionAngle = FMath::FInterpTo(DirectionAngle, PlayerRef->TurnRate, GetDeltaSeconds(), 0.0f);
+        bIsCrouching = Snapshot.bIsCrouching;
+        bIsSprint = Snapshot.bIsSprint;
+        LandState = Snapshot.LandState;
+        bIsJump = Snapshot.bIsJump;
+        bIsAim = Snapshot.bIsAim;
+        Pitch = Snapshot.Pitch;
+        bIsPistolEquip = Snapshot.bIsPistolEquip;
+        bIsRifleEquip = Snapshot.bIsRifleEquip;
+        DirectionAngle = FMath::FInterpTo(DirectionAngle, Snapshot.TurnRate, UpdateDeltaSeconds, 0.0f);
     }
 
     // Base character properties (available for all characters)
-    AnimationState = CharacterRef->CurrentAnimationState;
+    AnimationState = Snapshot.AnimationState;
 }
 
 void ULocomotionAnimInstance::RunningIntoWall()
@@ -126,19 +193,19 @@ void ULocomotionAnimInstance::UpdateAcceleration()
     float AccelerationLength = LocalAcceleration2D.SizeSquared2D();
     bHasAcceleration = !FMath::IsNearlyEqual(AccelerationLength, 0.0f, 0.000001f);
 
-    WorldAcceleration2D = MovementComponent->GetCurrentAcceleration() * FVector(1.0f, 1.0f, 0.0f);
+    WorldAcceleration2D = Snapshot.Acceleration * FVector(1.0f, 1.0f, 0.0f);
     LocalAcceleration2D = WorldRotation.UnrotateVector(WorldAcceleration2D);
     WorldVelocity2D = WorldVelocity * FVector(1.0f, 1.0f, 0.0f);
     LocalVelocity2D = WorldRotation.UnrotateVector(WorldVelocity2D);
 
-    WorldRotation = GetOwningActor()->GetActorRotation();
-    WorldVelocity = GetOwningActor()->GetVelocity();
+    WorldRotation = Snapshot.ActorRotation;
+    WorldVelocity = Snapshot.ActorVelocity;
 }
 
 void ULocomotionAnimInstance::UpdateLocomotionDirection()
 {
     FVector VelocityXY = FVector(Velocity.X, Velocity.Y, 0.0f);
-    FRotator ActorRotation = CharacterRef->GetActorRotation();
+    FRotator ActorRotation = Snapshot.ActorRotation;
 
     // Normalize the direction to -180 to 180 range
     Direction = FRotator::NormalizeAxis(CalculateDirection(VelocityXY, ActorRotation));
@@ -175,23 +242,22 @@ void ULocomotionAnimInstance::TurnInPlace()
     if (bShouldMove || bIsFalling)
     {
         // TODO: RootYawOffset Default Value
-        RootYawOffset = FMath::FInterpTo(RootYawOffset, 0.0f, GetDeltaSeconds(), 20.0f);
-        MovingRotation = CharacterRef->GetActorRotation();
+        RootYawOffset = FMath::FInterpTo(RootYawOffset, 0.0f, UpdateDeltaSeconds, 20.0f);
+        MovingRotation = Snapshot.ActorRotation;
         LastMovingRotation = MovingRotation;
     }
     else
     {
         LastMovingRotation = MovingRotation;
-        MovingRotation = CharacterRef->GetActorRotation();
+        MovingRotation = Snapshot.ActorRotation;
         // Delta(Rotator)
         RootYawOffset = RootYawOffset - (MovingRotation - LastMovingRotation).GetNormalized().Yaw;
 
-        // TODO: Curve Name?
-        if (GetCurveValue(FName("IsTurn")) > 0.0f)
+        if (Snapshot.IsTurnCurve > 0.0f)
         {
             LastDistanceCurve = DistanceCurve;
 
-            DistanceCurve = GetCurveValue(FName("DistanceCurve"));
+            DistanceCurve = Snapshot.DistanceCurve;
             DeltaDistanceCurve = DistanceCurve - LastDistanceCurve;
             if (RootYawOffset > 0.0f)
             {
@@ -104,6 +104,8 @@ void APlayer_Base::Tick(float DeltaTime)
 	Super::Tick(DeltaTime); // Base class ticks Aim and Crouch timelines
 
 	ShoulderCameraTimeline.TickTimeline(DeltaTime);
+
+	HandleFiring(DeltaTime);
 }
 
 void APlayer_Base::OnLanded(const FHitResult& Hit)
@@ -143,6 +145,7 @@ void APlayer_Base::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 
 		// Shooting
 		EnhancedInputComponent->BindAction(ShootAction, ETriggerEvent::Triggered, this, &APlayer_Base::ShootFire);
+		EnhancedInputComponent->BindAction(ShootAction, ETriggerEvent::Completed, this, &APlayer_Base::StopFire);
 		EnhancedInputComponent->BindAction(AimAction, ETriggerEvent::Triggered, this, &APlayer_Base::Aim);
 		EnhancedInputComponent->BindAction(ReloadAction, ETriggerEvent::Triggered, this, &APlayer_Base::Reload);
 
@@ -203,8 +206,8 @@ void APlayer_Base::ShootFire(const FInputActionValue& Value)
 	if (!bIsAim)
 		return;
 
+	// Shots themselves are released by HandleFiring in Tick
 	bFiring = Value.Get<bool>();
-	HandleFiring();
 }
 
 void APlayer_Base::Aim(const FInputActionValue& Value)
@@ -402,48 +405,46 @@ void APlayer_Base::StopFire()
 	bFiring = false;
 }
 
-void APlayer_Base::HandleFiring()
+void APlayer_Base::HandleFiring(float DeltaTime)
 {
-	if (!EquipmentSystem)
+	AMasterWeapon* MasterWeapon = GetEquippedWeapon();
+	UWeaponData* CurrentWeaponDataAsset = MasterWeapon ? MasterWeapon->WeaponData : nullptr;
+	if (!CurrentWeaponDataAsset)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[HandleFiring] Blocked: EquipmentSystem is null"));
+		FireScheduler.Advance(DeltaTime, false);
 		return;
 	}
 
-	if (!bFiring)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[HandleFiring] Blocked: bFiring is false"));
-		return;
-	}
+	// Fire as many shots as fall inside this frame, so the rate does not depend on frame time;
+	// semi-auto and burst then wait for the trigger to be released
+	FireScheduler.SetShotInterval(CurrentWeaponDataAsset->FireRate);
+	FireScheduler.SetShotsPerPress(CurrentWeaponDataAsset->GetShotsPerPress());
+	const bool bTriggerHeld = bFiring && bIsAim;
+	const int32 NumShots = FireScheduler.Advance(DeltaTime, bTriggerHeld, CanFire());
 
-	if (!bCanFire)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[HandleFiring] Blocked: bCanFire is false"));
-		return;
-	}
+	// bCanFire mirrors the scheduler for Blueprint/animation readers: false while the weapon cycles between shots
+	bCanFire = FireScheduler.GetCooldown() <= 0.0;
 
-	if (!CanFire())
+	for (int32 Shot = 0; Shot < NumShots; ++Shot)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[HandleFiring] Blocked: CanFire() returned false"));
-		return;
+		ReadyToFire(MasterWeapon, CurrentWeaponDataAsset);
 	}
+}
+
+AMasterWeapon* APlayer_Base::GetEquippedWeapon() const
+{
+	if (!EquipmentSystem)
+		return nullptr;
 
 	if (EquipmentSystem->CurrentEquippedSlot == EEquipmentSlot::Primary)
 	{
-		AMasterWeapon* MasterWeapon = Cast<AMasterWeapon>(PrimaryChild->GetChildActor());
-		UWeaponData* CurrentWeaponDataAsset = MasterWeapon->WeaponData;
-		ReadyToFire(MasterWeapon, CurrentWeaponDataAsset);
+		return PrimaryChild ? Cast<AMasterWeapon>(PrimaryChild->GetChildActor()) : nullptr;
 	}
-	else if (EquipmentSystem->CurrentEquippedSlot == EEquipmentSlot::Handgun)
+	if (EquipmentSystem->CurrentEquippedSlot == EEquipmentSlot::Handgun)
 	{
-		AMasterWeapon* MasterWeapon = Cast<AMasterWeapon>(HandgunChild->GetChildActor());
-		UWeaponData* CurrentWeaponDataAsset = MasterWeapon->WeaponData;
-		ReadyToFire(MasterWeapon, CurrentWeaponDataAsset);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[HandleFiring] No weapon equipped!"));
+		return HandgunChild ? Cast<AMasterWeapon>(HandgunChild->GetChildActor()) : nullptr;
 	}
+	return nullptr;
 }
 
 bool APlayer_Base::CanFire()
@@ -689,7 +690,6 @@ void APlayer_Base::ReadyToFire(AMasterWeapon* MasterWeapon, UWeaponData* Current
 	if (!MasterWeapon || !CurrentWeaponDataAsset)
 		return;
 	
-	bCanFire = false;
 	MasterWeapon->Fire();
 
 	APlayerController* PC = Cast<APlayerController>(GetController());
@@ -703,37 +703,6 @@ void APlayer_Base::ReadyToFire(AMasterWeapon* MasterWeapon, UWeaponData* Current
 				MasterWeapon->WeaponSystem->Weapon_Details.Weapon_Data.CurrentAmmo);
 		}
 	}
-
-	float FireDelay = CurrentWeaponDataAsset->FireRate;
-	EFireMode CurrentFireMode = CurrentWeaponDataAsset->FireMode;
-	FTimerHandle TimerHandle;
-
-	switch (CurrentFireMode)
-	{
-	case EFireMode::FullAuto:
-		GetWorld()->GetTimerManager().SetTimer(
-			TimerHandle,
-			[this]()
-			{
-				bCanFire = true;
-				HandleFiring();
-			},
-			FireDelay,
-			false
-		);
-		break;
-	default:
-		GetWorld()->GetTimerManager().SetTimer(
-			TimerHandle,
-			[this]()
-			{
-				bCanFire = true;
-			},
-			FireDelay,
-			false
-		);
-		break;
-	}
 }
 
 void APlayer_Base::Interact()
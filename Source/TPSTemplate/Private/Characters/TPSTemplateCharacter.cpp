@@ -414,10 +414,16 @@ float ATPSTemplateCharacter::TakeDamage_Implementation(float DamageAmount, const
 	FVector HitLocation = DamageEvent.HitInfo.ImpactPoint;
 	FVector HitDirection = DamageEvent.ShotDirection;
 	
-	// TODO: Procedural Hit Reaction
-	// Hurtbox->ApplyHitReaction(HitLocation, HitDirection, HitBoneName, 500.f);
+	// Physical flinch on the hit bone; UHitReactionSubsystem decides whether it is in budget and in range
+	if (HitBoneName != NAME_None)
+	{
+		Hurtbox->ApplyHitReaction(HitLocation, HitDirection, HitBoneName, 500.f);
+	}
 	
-	float Multiplier = Hurtbox->GetDamageMultiplier(HitBoneName);
+	// Weapon hits carry the physics body of the bone - resolve through the baked body table
+	float Multiplier = DamageEvent.HitInfo.BoneName == HitBoneName
+		? Hurtbox->GetDamageMultiplierForHit(DamageEvent.HitInfo)
+		: Hurtbox->GetDamageMultiplier(HitBoneName);
 	float ModifiedDamage = DamageAmount * Multiplier;
 	
 	HealthComponent->ApplyDamage(ModifiedDamage);
@@ -7,6 +7,8 @@
 #include "Characters/TPSTemplateCharacter.h"
 #include "Data/WeaponData.h"
 #include "Data/InventoryTypes.h"
+#include "Data/InventorySaveData.h"
+#include "Engine/AssetManager.h"
 
 // Sets default values for this component's properties
 UEquipmentSystem::UEquipmentSystem()
@@ -38,7 +40,9 @@ void UEquipmentSystem::Equip(EEquipmentSlot Slot, UItemData* ItemData)
 	UChildActorComponent* TargetChild = *TargetChildPtr;
 	// 2. 타겟 Child Actor에 등록하기
 	SetChildActorForSlot(Slot, TargetChild);
-	if (!TargetChild->GetChildActor() && EquipSlot.EquipmentClass)
+	// Respawn when the slot is empty or still holds a different item's actor
+	AActor* ExistingChild = TargetChild->GetChildActor();
+	if (EquipSlot.EquipmentClass && (!ExistingChild || ExistingChild->GetClass() != EquipSlot.EquipmentClass))
 	{
 		TargetChild->SetChildActorClass(EquipSlot.EquipmentClass);
 		TargetChild->CreateChildActor();
@@ -83,6 +87,12 @@ UWeaponData* UEquipmentSystem::Unequip(EEquipmentSlot Slot)
 		return nullptr;
 	}
 
+	ClearSlot(Slot);
+	return WeaponData;
+}
+
+void UEquipmentSystem::ClearSlot(EEquipmentSlot Slot)
+{
 	UChildActorComponent* TargetChild = GetChildActorForSlot(Slot);
 	if (TargetChild && TargetChild->GetChildActor())
 	{
@@ -101,8 +111,6 @@ UWeaponData* UEquipmentSystem::Unequip(EEquipmentSlot Slot)
 			CharacterRef->CurrentAnimationState = EAnimationState::Unarmed;
 		}
 	}
-	
-	return WeaponData;
 }
 
 void UEquipmentSystem::BeginPlay()
@@ -320,7 +328,7 @@ void UEquipmentSystem::EquipFromInventory(FGuid InstanceID, EEquipmentSlot Targe
 		return;
 	}
 
-	UItemData* ItemData = ItemSlot->ItemData.Get();
+	UItemData* ItemData = ItemSlot->GetItemData();
 	if (!ItemData)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[EquipFromInventory] ItemData is null"));
@@ -461,3 +469,89 @@ bool UEquipmentSystem::PickupAndEquipWeapon(TSubclassOf<AMasterWeapon> NewWeapon
 
 	return true;
 }
+
+void UEquipmentSystem::WriteSaveData(FInventorySaveData& OutData) const
+{
+	for (const auto& Pair : Equipped)
+	{
+		const int32 AssetIndex = OutData.FindOrAddAsset(Pair.Value.ItemData.Get());
+		if (AssetIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FInventorySaveData::FEquipmentRecord& Record = OutData.Equipment.AddDefaulted_GetRef();
+		Record.Slot = Pair.Key;
+		Record.AssetIndex = AssetIndex;
+
+		UChildActorComponent* const* ChildPtr = SlotToChildActor.Find(Pair.Key);
+		const AMasterWeapon* Weapon = ChildPtr && *ChildPtr ? Cast<AMasterWeapon>((*ChildPtr)->GetChildActor()) : nullptr;
+		if (Weapon && Weapon->WeaponSystem)
+		{
+			const FWeapon_Data& WeaponData = Weapon->WeaponSystem->Weapon_Details.Weapon_Data;
+			Record.bHasAmmo = true;
+			Record.Ammo.CurrentAmmo = WeaponData.CurrentAmmo;
+			Record.Ammo.MaxAmmo = WeaponData.MaxAmmo;
+			Record.Ammo.ClipAmmo = WeaponData.ClipAmmo;
+			Record.Ammo.DifferentAmmo = WeaponData.DifferentAmmo;
+			Record.Ammo.AmmoCount = WeaponData.Ammo_Count;
+		}
+	}
+}
+
+void UEquipmentSystem::ApplySaveData(const FInventorySaveData& Data)
+{
+	// Slots the snapshot does not list were empty when it was taken
+	TArray<EEquipmentSlot> OccupiedSlots;
+	Equipped.GetKeys(OccupiedSlots);
+	for (const TPair<EEquipmentSlot, UChildActorComponent*>& Pair : SlotToChildActor)
+	{
+		if (Pair.Value && Pair.Value->GetChildActor())
+		{
+			OccupiedSlots.AddUnique(Pair.Key);
+		}
+	}
+	for (const EEquipmentSlot Slot : OccupiedSlots)
+	{
+		const bool bInRecord = Data.Equipment.ContainsByPredicate([Slot](const FInventorySaveData::FEquipmentRecord& Record)
+		{
+			return Record.Slot == Slot;
+		});
+		if (!bInRecord)
+		{
+			ClearSlot(Slot);
+		}
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	for (const FInventorySaveData::FEquipmentRecord& Record : Data.Equipment)
+	{
+		UItemData* ItemData = AssetManager.GetPrimaryAssetObject<UItemData>(Data.Assets[Record.AssetIndex]);
+		if (!ItemData)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[EquipmentSystem] ApplySaveData: %s is not loaded, slot %d cleared"),
+				*Data.Assets[Record.AssetIndex].ToString(), (int32)Record.Slot);
+			ClearSlot(Record.Slot);
+			continue;
+		}
+
+		Equip(Record.Slot, ItemData);
+
+		if (!Record.bHasAmmo)
+		{
+			continue;
+		}
+
+		UChildActorComponent* TargetChild = GetChildActorForSlot(Record.Slot);
+		AMasterWeapon* Weapon = TargetChild ? Cast<AMasterWeapon>(TargetChild->GetChildActor()) : nullptr;
+		if (Weapon && Weapon->WeaponSystem)
+		{
+			FWeapon_Data& WeaponData = Weapon->WeaponSystem->Weapon_Details.Weapon_Data;
+			WeaponData.CurrentAmmo = Record.Ammo.CurrentAmmo;
+			WeaponData.MaxAmmo = Record.Ammo.MaxAmmo;
+			WeaponData.ClipAmmo = Record.Ammo.ClipAmmo;
+			WeaponData.DifferentAmmo = Record.Ammo.DifferentAmmo;
+			WeaponData.Ammo_Count = Record.Ammo.AmmoCount;
+		}
+	}
+}
@@ -4,22 +4,143 @@
 #include "Components/Hurtbox.h"
 
 #include "Characters/TPSTemplateCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkinnedAsset.h"
+#include "PhysicsEngine/PhysicsAsset.h"
 #include "PhysicsEngine/PhysicalAnimationComponent.h"
+#include "Subsystems/HitReactionSubsystem.h"
+
+void UHurtbox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BakeDamageMultipliers();
+}
+
+void UHurtbox::BakeDamageMultipliers()
+{
+	BoneMultipliers.Reset();
+	BodyMultipliers.Reset();
+	BoneMultipliersByName.Reset();
+	BakedMesh.Reset();
+	BakedSkinnedAsset.Reset();
+	BakedPhysicsAsset.Reset();
+
+	const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+	USkeletalMeshComponent* Mesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+	USkinnedAsset* SkinnedAsset = Mesh ? Mesh->GetSkinnedAsset() : nullptr;
+	if (!SkinnedAsset)
+	{
+		return;
+	}
+
+	// Parents always precede their children in the reference skeleton, so one forward pass resolves inheritance
+	const FReferenceSkeleton& RefSkeleton = SkinnedAsset->GetRefSkeleton();
+	const int32 NumBones = RefSkeleton.GetNum();
+	BoneMultipliers.SetNumUninitialized(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		if (const float* Multiplier = DamageMultipliers.Find(RefSkeleton.GetBoneName(BoneIndex)))
+		{
+			BoneMultipliers[BoneIndex] = *Multiplier;
+			continue;
+		}
+
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		BoneMultipliers[BoneIndex] = ParentIndex != INDEX_NONE ? BoneMultipliers[ParentIndex] : 1.0f;
+	}
+
+	BoneMultipliersByName.Reserve(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		BoneMultipliersByName.Add(RefSkeleton.GetBoneName(BoneIndex), BoneMultipliers[BoneIndex]);
+	}
+
+	BodyMultipliers.SetNumUninitialized(Mesh->Bodies.Num());
+	for (int32 BodyIndex = 0; BodyIndex < Mesh->Bodies.Num(); ++BodyIndex)
+	{
+		const FBodyInstance* Body = Mesh->Bodies[BodyIndex];
+		const int32 BoneIndex = Body ? Body->InstanceBoneIndex : INDEX_NONE;
+		BodyMultipliers[BodyIndex] = BoneMultipliers.IsValidIndex(BoneIndex) ? BoneMultipliers[BoneIndex] : 1.0f;
+	}
+
+	BakedMesh = Mesh;
+	BakedSkinnedAsset = SkinnedAsset;
+	BakedPhysicsAsset = Mesh->GetPhysicsAsset();
+}
+
+bool UHurtbox::IsBakeValid(const USkeletalMeshComponent* Mesh) const
+{
+	return Mesh
+		&& BakedMesh.Get() == Mesh
+		&& BakedSkinnedAsset.Get() == Mesh->GetSkinnedAsset()
+		&& BakedPhysicsAsset.Get() == Mesh->GetPhysicsAsset();
+}
 
 float UHurtbox::GetDamageMultiplier(const FName HitBoneName) const
 {
 	// 기본 배율
 	float Multiplier = 1.0f;
 
-	// BoneName이 유효하고 DamageMultipliers에 등록되어 있으면 해당 배율 사용
-	if (!HitBoneName.IsNone() && DamageMultipliers.Contains(HitBoneName))
+	if (HitBoneName.IsNone())
+	{
+		return Multiplier;
+	}
+
+	if (IsBakeValid(BakedMesh.Get()))
+	{
+		if (const float* Baked = BoneMultipliersByName.Find(HitBoneName))
+		{
+			return *Baked;
+		}
+	}
+
+	// Not baked yet (or the mesh changed): walk the current skeleton so child bones still inherit
+	const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+	const USkeletalMeshComponent* OwnerMesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+	const USkinnedAsset* SkinnedAsset = OwnerMesh ? OwnerMesh->GetSkinnedAsset() : nullptr;
+	if (SkinnedAsset)
+	{
+		const FReferenceSkeleton& RefSkeleton = SkinnedAsset->GetRefSkeleton();
+		const int32 BoneIndex = RefSkeleton.FindBoneIndex(HitBoneName);
+		if (BoneIndex != INDEX_NONE)
+		{
+			return FindInheritedMultiplier(RefSkeleton, BoneIndex);
+		}
+	}
+
+	// BoneName이 DamageMultipliers에 등록되어 있으면 해당 배율 사용
+	if (const float* Found = DamageMultipliers.Find(HitBoneName))
 	{
-		Multiplier = DamageMultipliers[HitBoneName];
+		Multiplier = *Found;
 	}
 
 	return Multiplier;
 }
 
+float UHurtbox::FindInheritedMultiplier(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex) const
+{
+	for (; BoneIndex != INDEX_NONE; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+	{
+		if (const float* Multiplier = DamageMultipliers.Find(RefSkeleton.GetBoneName(BoneIndex)))
+		{
+			return *Multiplier;
+		}
+	}
+	return 1.0f;
+}
+
+float UHurtbox::GetDamageMultiplierForHit(const FHitResult& HitResult) const
+{
+	const USkeletalMeshComponent* Mesh = BakedMesh.Get();
+	if (HitResult.GetComponent() == Mesh && IsBakeValid(Mesh) && BodyMultipliers.IsValidIndex(HitResult.Item))
+	{
+		return BodyMultipliers[HitResult.Item];
+	}
+
+	return GetDamageMultiplier(HitResult.BoneName);
+}
+
 void UHurtbox::ApplyHitReaction(const FVector& HitLocation, const FVector& HitDirection, const FName BoneName, float Force)
 {
 	if (!CharacterRef)
@@ -57,22 +178,39 @@ void UHurtbox::ApplyHitReaction(const FVector& HitLocation, const FVector& HitDi
 		return;
 	}
 
-	// 해당 본만 물리 활성화 및 설정
-	BodyInstance->SetInstanceSimulatePhysics(true);
-	BodyInstance->SetEnableGravity(false);  // 중력 비활성화로 바닥에 쓰러지는 것 방지
-	BodyInstance->PhysicsBlendWeight = 0.2f;  // 물리 영향 최소화 (0.5 → 0.2)
+	// 힘에 비례한 복구 시간 (500 → 0.5초)
+	const float RecoveryTime = FMath::Clamp(Force * 0.001f, MinRecoveryTime, MaxRecoveryTime);
+
+	UHitReactionSubsystem* HitReactions = World->GetSubsystem<UHitReactionSubsystem>();
+	const EHitReactionRequest Request = HitReactions
+		? HitReactions->RequestReaction(this, BoneName, HitLocation, RecoveryTime, MaxRecoveryTime)
+		: EHitReactionRequest::Skipped;
+
+	if (Request == EHitReactionRequest::Skipped)
+	{
+		return;
+	}
+
+	// 이미 반응 중인 본은 설정을 유지하고 임펄스만 추가
+	if (Request == EHitReactionRequest::Started)
+	{
+		// 해당 본만 물리 활성화 및 설정
+		BodyInstance->SetInstanceSimulatePhysics(true);
+		BodyInstance->SetEnableGravity(false);  // 중력 비활성화로 바닥에 쓰러지는 것 방지
+		BodyInstance->PhysicsBlendWeight = 0.2f;  // 물리 영향 최소화 (0.5 → 0.2)
 
-	// ✅ 단일 본에만 Physical Animation 적용 (강한 복원력)
-	FPhysicalAnimationData PhysAnimData;
-	PhysAnimData.bIsLocalSimulation = true;
-	PhysAnimData.OrientationStrength = 10000.0f;      // 애니메이션 포즈로 강하게 복귀
-	PhysAnimData.AngularVelocityStrength = 500.0f;   // 회전 속도 제어
-	PhysAnimData.PositionStrength = 10000.0f;         // 위치 복원력
-	PhysAnimData.VelocityStrength = 500.0f;          // 속도 제어
-	PhysAnimData.MaxLinearForce = 10000.0f;          // 최대 선형 힘
-	PhysAnimData.MaxAngularForce = 10000.0f;         // 최대 회전 힘
+		// ✅ 단일 본에만 Physical Animation 적용 (강한 복원력)
+		FPhysicalAnimationData PhysAnimData;
+		PhysAnimData.bIsLocalSimulation = true;
+		PhysAnimData.OrientationStrength = 10000.0f;      // 애니메이션 포즈로 강하게 복귀
+		PhysAnimData.AngularVelocityStrength = 500.0f;   // 회전 속도 제어
+		PhysAnimData.PositionStrength = 10000.0f;         // 위치 복원력
+		PhysAnimData.VelocityStrength = 500.0f;          // 속도 제어
+		PhysAnimData.MaxLinearForce = 10000.0f;          // 최대 선형 힘
+		PhysAnimData.MaxAngularForce = 10000.0f;         // 최대 회전 힘
 
-	PAC->ApplyPhysicalAnimationSettings(BoneName, PhysAnimData);
+		PAC->ApplyPhysicalAnimationSettings(BoneName, PhysAnimData);
+	}
 
 	// Z축 제거하여 공중으로 날아가는 것 방지
 	FVector SafeDir = HitDirection.GetSafeNormal();
@@ -80,18 +218,25 @@ void UHurtbox::ApplyHitReaction(const FVector& HitLocation, const FVector& HitDi
 
 	// 임펄스 힘 감소 (500 → 100)
 	Mesh->AddImpulseAtLocation(SafeDir * (Force * 0.2f), HitLocation, BoneName);
+}
+
+void UHurtbox::RecoverFromHit()
+{
+	UWorld* World = GetWorld();
+	if (UHitReactionSubsystem* HitReactions = World ? World->GetSubsystem<UHitReactionSubsystem>() : nullptr)
+	{
+		HitReactions->ReleaseAll(this);
+	}
+}
 
-	ActivatedBoneName = BoneName;
+void UHurtbox::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RecoverFromHit();
 
-	World->GetTimerManager().SetTimer(
-		RecoveryTimer,
-		this,
-		&UHurtbox::RecoverFromHit,
-		0.5f
-	);
+	Super::EndPlay(EndPlayReason);
 }
 
-void UHurtbox::RecoverFromHit()
+void UHurtbox::EndBoneReaction(FName BoneName)
 {
 	if (!CharacterRef)
 	{
@@ -106,7 +251,7 @@ void UHurtbox::RecoverFromHit()
 	if (!Mesh) return;
 
 	// ✅ 해당 본만 물리 해제 및 블렌드 가중치 복구
-	FBodyInstance* BodyInstance = Mesh->GetBodyInstance(ActivatedBoneName);
+	FBodyInstance* BodyInstance = Mesh->GetBodyInstance(BoneName);
 	if (BodyInstance)
 	{
 		BodyInstance->SetInstanceSimulatePhysics(false);
@@ -115,7 +260,5 @@ void UHurtbox::RecoverFromHit()
 
 	// Physical Animation 제거
 	FPhysicalAnimationData EmptyData;
-	PAC->ApplyPhysicalAnimationSettings(ActivatedBoneName, EmptyData);
-
-	ActivatedBoneName = NAME_None;
+	PAC->ApplyPhysicalAnimationSettings(BoneName, EmptyData);
 }
@@ -2,10 +2,71 @@
 
 #include "Components/InventorySystem.h"
 #include "Data/ItemData.h"
+#include "Data/InventorySaveData.h"
+#include "Engine/AssetManager.h"
+#include "Net/UnrealNetwork.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs NetBenchmarkCommand(
+		TEXT("tps.Inventory.NetBenchmark"),
+		TEXT("tps.Inventory.NetBenchmark [ItemDataPath] [Frames=60]: listen server, measure replication bytes per pickup into the host player's inventory (default item: the first one it holds)."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+			const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+			UInventorySystem* Inventory = Pawn ? Pawn->FindComponentByClass<UInventorySystem>() : nullptr;
+			if (!Inventory)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] tps.Inventory.NetBenchmark needs a possessed pawn with an inventory"));
+				return;
+			}
+
+			UItemData* ItemData = nullptr;
+			if (Args.Num() > 0)
+			{
+				ItemData = Cast<UItemData>(FSoftObjectPath(Args[0]).TryLoad());
+			}
+			else if (Inventory->GetItems().Num() > 0)
+			{
+				ItemData = Inventory->GetItems()[0].ResolvedItemData;
+			}
+
+			const int32 Frames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 60;
+			Inventory->RunNetBenchmark(ItemData, Frames);
+		}),
+		ECVF_Cheat
+	);
+}
+
+void FInventoryItemArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (Owner)
+	{
+		Owner->OnItemsReplicated();
+	}
+}
 
 UInventorySystem::UInventorySystem()
 {
 	PrimaryComponentTick.bCanEverTick = false;
+
+	SetIsReplicatedByDefault(true);
+}
+
+void UInventorySystem::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Set after property init so the archetype's copy of ItemList never leaves Owner pointing at the template
+	ItemList.Owner = this;
 }
 
 void UInventorySystem::BeginPlay()
@@ -14,47 +75,59 @@ void UInventorySystem::BeginPlay()
 	InitializeGrid();
 }
 
-//==============================================================================
-// Public API
-//==============================================================================
+void UInventorySystem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UInventorySystem, ItemList);
+}
 
-bool UInventorySystem::CanPlaceItem(UItemData* ItemData, int32 GridRow, int32 GridCol) const
+void UInventorySystem::OnItemsReplicated()
 {
-	if (!ItemData)
+	// Replicated slots arrive as soft references; rebuild now with the item data already in memory (slots still
+	// loading stay off the grid), then again once the async load finishes - never a blocking load per slot
+	TArray<TSoftObjectPtr<UItemData>> UnloadedAssets;
+	for (const FItemSlot& Item : ItemList.Items)
 	{
-		return false;
+		if (!Item.IsResolved() && !Item.ItemData.IsNull() && !Item.ItemData.IsValid())
+		{
+			UnloadedAssets.AddUnique(Item.ItemData);
+		}
 	}
 
-	// Check if item fits within grid bounds
-	if (GridRow < 0 || GridCol < 0 ||
-		GridRow + ItemData->GridHeight > RowCapacity ||
-		GridCol + ItemData->GridWidth > ColCapacity)
-	{
-		return false;
-	}
+	RebuildDerivedState();
+	NotifyInventoryChanged();
 
-	// Check if all required cells are free
-	for (int32 r = 0; r < ItemData->GridHeight; ++r)
+	if (UnloadedAssets.Num() > 0)
 	{
-		for (int32 c = 0; c < ItemData->GridWidth; ++c)
+		PreloadItemData(UnloadedAssets, FStreamableDelegate::CreateWeakLambda(this, [this]()
 		{
-			int32 CheckRow = GridRow + r;
-			int32 CheckCol = GridCol + c;
-			int32 Index = GetGridIndex(CheckRow, CheckCol);
+			RebuildDerivedState();
+			NotifyInventoryChanged();
+		}));
+	}
+}
 
-			// Cell is occupied if it has a valid GUID
-			// TODO: 1개 이하일 때 ReplaceItem호출
-			if (GridCells[Index].IsValid())
-			{
-				return false;
-			}
-		}
+//==============================================================================
+// Public API
+//==============================================================================
+
+bool UInventorySystem::CanPlaceItem(UItemData* ItemData, int32 GridRow, int32 GridCol, bool bRotated) const
+{
+	if (!ItemData)
+	{
+		return false;
 	}
 
-	return true;
+	const int32 Width = bRotated ? ItemData->GridHeight : ItemData->GridWidth;
+	const int32 Height = bRotated ? ItemData->GridWidth : ItemData->GridHeight;
+
+	// Bounds check + one mask test per covered row
+	// TODO: 1개 이하일 때 ReplaceItem호출
+	return Occupancy.IsFree(GridRow, GridCol, Width, Height);
 }
 
-bool UInventorySystem::AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol, int32 Quantity)
+bool UInventorySystem::AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol, int32 Quantity, bool bRotated)
 {
 	if (!ItemData || Quantity <= 0)
 	{
@@ -63,7 +136,7 @@ bool UInventorySystem::AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol
 	}
 
 	// Check if item can be placed
-	if (!CanPlaceItem(ItemData, GridRow, GridCol))
+	if (!CanPlaceItem(ItemData, GridRow, GridCol, bRotated))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AddItem failed: Cannot place item at (%d, %d)"), GridRow, GridCol);
 		return false;
@@ -82,19 +155,21 @@ bool UInventorySystem::AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol
 	FItemSlot NewSlot(ItemData, Quantity);
 	NewSlot.GridRow = GridRow;
 	NewSlot.GridCol = GridCol;
+	NewSlot.bRotated = bRotated;
 
 	// Add to items array
-	Items.Add(NewSlot);
+	const int32 NewIndex = AddItemSlot(NewSlot);
 
 	// Occupy grid cells
-	OccupyGridCells(NewSlot);
+	OccupyGridCells(NewIndex);
 
 	// Update weight
-	CurrentWeight += ItemWeight;
+	ApplyWeightDelta(ItemWeight);
 
 	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Added item '%s' at (%d, %d), Weight: %.2f/%.2f"),
 		*ItemData->ItemName.ToString(), GridRow, GridCol, CurrentWeight, MaxWeight);
 
+	NotifyInventoryChanged();
 	return true;
 }
 
@@ -114,83 +189,451 @@ bool UInventorySystem::TryAddItemEmptySpot(UItemData* ItemData, int32 Quantity)
 		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AddItem failed: Weight limit exceeded"));
 		return false;
 	}
-	if (ItemData->bStackable)
+	const int32 RequestedQuantity = Quantity;
+	Quantity = StackIntoExisting(ItemData, Quantity);
+	if (Quantity <= 0)
 	{
-		int32 RemainingQuantity = Quantity;
+		NotifyInventoryChanged();
+		return true;
+	}
+	
+	int32 EmptyRow, EmptyCol;
+	if (FindEmptySpot(ItemData, EmptyRow, EmptyCol))
+	{
+		return AddItem(ItemData, EmptyRow, EmptyCol, Quantity);
+	}
+	else
+	{
+		// Part of the quantity may already have been stacked
+		if (Quantity != RequestedQuantity)
+		{
+			NotifyInventoryChanged();
+		}
+		UE_LOG(LogTemp, Warning, TEXT("Can't find Empty Spot in Inventory"));
+		return false;
+	}
+}
 
-		for (FItemSlot& Slot : Items)
+FItemAddBatchResult UInventorySystem::AddItems(TArrayView<const FItemAddRequest> Requests, bool bAllOrNothing)
+{
+	FItemAddBatchResult Result;
+	if (Requests.Num() == 0)
+	{
+		// Empty loot roll and the like: nothing to do, nothing to report
+		return Result;
+	}
+
+	// A new slot this batch will create
+	struct FPlannedPlacement
+	{
+		UItemData* ItemData;
+		int32 GridRow;
+		int32 GridCol;
+		int32 Quantity;
+	};
+
+	// Planning never touches Items: placements go into a scratch copy of the occupancy,
+	// stack merges into per-slot counters, so a failed request (or batch) leaves no trace
+	FInventoryOccupancyGrid PlannedOccupancy = Occupancy;
+	TMap<int32, int32> PlannedStackAdds;
+	TArray<FPlannedPlacement> PlannedPlacements;
+	float PlannedWeight = 0.0f;
+
+	for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+	{
+		const FItemAddRequest& Request = Requests[RequestIndex];
+		UItemData* ItemData = Request.ItemData;
+		if (!ItemData || Request.Quantity <= 0)
 		{
-			if (Slot.ItemData.LoadSynchronous() == ItemData && Slot.Quantity < ItemData->MaxStackSize)
+			Result.FailedRequests.Add(RequestIndex);
+			continue;
+		}
+
+		const float ItemWeight = ItemData->GetTotalWeight(Request.Quantity);
+		if (CurrentWeight + PlannedWeight + ItemWeight > MaxWeight)
+		{
+			Result.FailedRequests.Add(RequestIndex);
+			continue;
+		}
+
+		// Stack into existing slots first, then into slots planned earlier in this batch
+		int32 Remaining = Request.Quantity;
+		TArray<TPair<int32, int32>, TInlineAllocator<4>> StagedStacks;
+		TArray<TPair<int32, int32>, TInlineAllocator<4>> StagedPlannedStacks;
+		if (ItemData->bStackable)
+		{
+			const TArray<int32>* OpenStacks = OpenStacksByItem.Find(ItemData);
+			for (int32 k = 0; OpenStacks && k < OpenStacks->Num() && Remaining > 0; ++k)
 			{
-				int32 CanAddNum = FMath::Min(RemainingQuantity, ItemData->MaxStackSize - Slot.Quantity);
-				Slot.Quantity += CanAddNum;
-				RemainingQuantity -= CanAddNum;
-				
-				UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Stacked %d items (Remaining: %d)"), CanAddNum, RemainingQuantity);
+				const int32 i = (*OpenStacks)[k];
+				const int32 Space = ItemData->MaxStackSize - ItemList.Items[i].Quantity - PlannedStackAdds.FindRef(i);
+				if (Space > 0)
+				{
+					const int32 AddNum = FMath::Min(Space, Remaining);
+					StagedStacks.Emplace(i, AddNum);
+					Remaining -= AddNum;
+				}
+			}
 
-				if (RemainingQuantity <= 0)
+			for (int32 p = 0; p < PlannedPlacements.Num() && Remaining > 0; ++p)
+			{
+				if (PlannedPlacements[p].ItemData != ItemData)
 				{
-					RecalculateWeight();
-					return true;
+					continue;
+				}
+
+				const int32 Space = ItemData->MaxStackSize - PlannedPlacements[p].Quantity;
+				if (Space > 0)
+				{
+					const int32 AddNum = FMath::Min(Space, Remaining);
+					StagedPlannedStacks.Emplace(p, AddNum);
+					Remaining -= AddNum;
 				}
 			}
 		}
 
-		Quantity = RemainingQuantity;
+		// Whatever did not stack needs a new slot (first-fit, same as TryAddItemEmptySpot)
+		int32 Row = -1;
+		int32 Col = -1;
+		if (Remaining > 0)
+		{
+			if (!PlannedOccupancy.FindFirstFit(ItemData->GridWidth, ItemData->GridHeight, Row, Col))
+			{
+				Result.FailedRequests.Add(RequestIndex);
+				continue;
+			}
+			PlannedOccupancy.Mark(Row, Col, ItemData->GridWidth, ItemData->GridHeight);
+		}
+
+		// Request fits: fold its staged changes into the plan
+		for (const TPair<int32, int32>& Stack : StagedStacks)
+		{
+			PlannedStackAdds.FindOrAdd(Stack.Key) += Stack.Value;
+		}
+		for (const TPair<int32, int32>& Stack : StagedPlannedStacks)
+		{
+			PlannedPlacements[Stack.Key].Quantity += Stack.Value;
+		}
+		if (Remaining > 0)
+		{
+			PlannedPlacements.Add({ ItemData, Row, Col, Remaining });
+		}
+		PlannedWeight += ItemWeight;
+		++Result.NumAdded;
 	}
-	
-	int32 EmptyRow, EmptyCol;
-	if (FindEmptySpot(ItemData, EmptyRow, EmptyCol))
+
+	if (Result.NumAdded == 0 || (bAllOrNothing && Result.FailedRequests.Num() > 0))
 	{
-		return AddItem(ItemData, EmptyRow, EmptyCol, Quantity);
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AddItems: nothing committed (%d of %d requests failed)"),
+			Result.FailedRequests.Num(), Requests.Num());
+		Result.NumAdded = 0;
+		return Result;
 	}
-	else
+
+	// Commit
+	for (const TPair<int32, int32>& Stack : PlannedStackAdds)
+	{
+		ItemList.Items[Stack.Key].Quantity += Stack.Value;
+		UpdateOpenStack(Stack.Key);
+		MarkItemDirty(Stack.Key);
+	}
+
+	ItemList.Items.Reserve(ItemList.Items.Num() + PlannedPlacements.Num());
+	for (const FPlannedPlacement& Placement : PlannedPlacements)
+	{
+		FItemSlot NewSlot(Placement.ItemData, Placement.Quantity);
+		NewSlot.GridRow = Placement.GridRow;
+		NewSlot.GridCol = Placement.GridCol;
+		OccupyGridCells(AddItemSlot(NewSlot));
+	}
+
+	ApplyWeightDelta(PlannedWeight);
+	Result.bCommitted = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] AddItems: %d/%d requests added (%d stacks merged, %d new slots), Weight: %.2f/%.2f"),
+		Result.NumAdded, Requests.Num(), PlannedStackAdds.Num(), PlannedPlacements.Num(), CurrentWeight, MaxWeight);
+
+	NotifyInventoryChanged();
+	return Result;
+}
+
+bool UInventorySystem::TryAddItemBestFit(UItemData* ItemData, int32 Quantity, bool bAllowRotation)
+{
+	if (!ItemData || Quantity <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AddItem failed: Invalid ItemData or Quantity"));
+		return false;
+	}
+
+	// Check weight limit
+	float ItemWeight = ItemData->GetTotalWeight(Quantity);
+	if (CurrentWeight + ItemWeight > MaxWeight)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AddItem failed: Weight limit exceeded"));
+		return false;
+	}
+
+	const int32 RequestedQuantity = Quantity;
+	Quantity = StackIntoExisting(ItemData, Quantity);
+	if (Quantity <= 0)
+	{
+		NotifyInventoryChanged();
+		return true;
+	}
+
+	int32 BestRow, BestCol;
+	bool bRotated;
+	if (!FindBestFitSpot(FItemFootprint(*ItemData), bAllowRotation, BestRow, BestCol, bRotated))
 	{
+		// Part of the quantity may already have been stacked
+		if (Quantity != RequestedQuantity)
+		{
+			NotifyInventoryChanged();
+		}
 		UE_LOG(LogTemp, Warning, TEXT("Can't find Empty Spot in Inventory"));
 		return false;
 	}
+
+	return AddItem(ItemData, BestRow, BestCol, Quantity, bRotated);
 }
 
-bool UInventorySystem::RemoveItem(FGuid InstanceId)
+bool UInventorySystem::AutoArrange(bool bAllowRotation)
 {
-	// Find item by InstanceId
-	int32 ItemIndex = Items.IndexOfByPredicate([&](const FItemSlot& Slot)
+	// Placement order: largest area first, longer side first on ties
+	TArray<int32> Order;
+	for (int32 i = 0; i < ItemList.Items.Num(); ++i)
 	{
-		return Slot.InstanceId == InstanceId;
+		if (ItemList.Items[i].IsPlacedInGrid() && ItemList.Items[i].IsResolved())
+		{
+			Order.Add(i);
+		}
+	}
+
+	Order.Sort([this](int32 A, int32 B)
+	{
+		const FItemFootprint& FA = ItemList.Items[A].Footprint;
+		const FItemFootprint& FB = ItemList.Items[B].Footprint;
+		const int32 AreaA = FA.GridWidth * FA.GridHeight;
+		const int32 AreaB = FB.GridWidth * FB.GridHeight;
+		if (AreaA != AreaB)
+		{
+			return AreaA > AreaB;
+		}
+		return FMath::Max(FA.GridWidth, FA.GridHeight) > FMath::Max(FB.GridWidth, FB.GridHeight);
 	});
 
+	// Remember the current layout so a failed repack can be undone
+	struct FSavedPlacement
+	{
+		int32 GridRow;
+		int32 GridCol;
+		bool bRotated;
+	};
+	TArray<FSavedPlacement> Saved;
+	Saved.Reserve(Order.Num());
+	for (int32 ItemIndex : Order)
+	{
+		Saved.Add({ ItemList.Items[ItemIndex].GridRow, ItemList.Items[ItemIndex].GridCol, ItemList.Items[ItemIndex].bRotated });
+		ClearGridCells(ItemIndex);
+	}
+
+	for (int32 i = 0; i < Order.Num(); ++i)
+	{
+		FItemSlot& Item = ItemList.Items[Order[i]];
+
+		int32 Row, Col;
+		bool bRotated;
+		if (!FindBestFitSpot(Item.Footprint, bAllowRotation, Row, Col, bRotated))
+		{
+			// Roll back: clear what was repacked, restore every original placement
+			for (int32 j = 0; j < i; ++j)
+			{
+				ClearGridCells(Order[j]);
+			}
+			for (int32 j = 0; j < Order.Num(); ++j)
+			{
+				FItemSlot& Restore = ItemList.Items[Order[j]];
+				Restore.GridRow = Saved[j].GridRow;
+				Restore.GridCol = Saved[j].GridCol;
+				Restore.bRotated = Saved[j].bRotated;
+				OccupyGridCells(Order[j]);
+				MarkItemDirty(Order[j]);
+			}
+
+			UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] AutoArrange failed: items do not fit, layout restored"));
+			return false;
+		}
+
+		Item.GridRow = Row;
+		Item.GridCol = Col;
+		Item.bRotated = bRotated;
+		OccupyGridCells(Order[i]);
+		MarkItemDirty(Order[i]);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] AutoArrange packed %d items, density %.2f"), Order.Num(), GetPackDensity());
+
+	NotifyInventoryChanged();
+	return true;
+}
+
+int32 UInventorySystem::MergeAllStacks()
+{
+	// Only stacks with room can take or give quantity, and OpenStacksByItem already groups those by type
+	TArray<FGuid> EmptiedSlots;
+	for (TPair<UItemData*, TArray<int32>>& Pair : OpenStacksByItem)
+	{
+		TArray<int32>& OpenStacks = Pair.Value;
+		const int32 MaxStackSize = Pair.Key ? Pair.Key->MaxStackSize : 0;
+
+		// Two pointers: pour the back stacks into the front ones
+		int32 Front = 0;
+		int32 Back = OpenStacks.Num() - 1;
+		while (Front < Back)
+		{
+			FItemSlot& Target = ItemList.Items[OpenStacks[Front]];
+			FItemSlot& Source = ItemList.Items[OpenStacks[Back]];
+
+			const int32 MoveNum = FMath::Min(MaxStackSize - Target.Quantity, Source.Quantity);
+			Target.Quantity += MoveNum;
+			Source.Quantity -= MoveNum;
+			MarkItemDirty(OpenStacks[Front]);
+			MarkItemDirty(OpenStacks[Back]);
+
+			if (Source.Quantity <= 0)
+			{
+				EmptiedSlots.Add(Source.InstanceId);
+				--Back;
+			}
+			if (Target.Quantity >= MaxStackSize)
+			{
+				++Front;
+			}
+		}
+
+		// Everything before Front is now full and everything after Back is empty; Front itself may still have room
+		for (int32 k = 0; k < OpenStacks.Num(); ++k)
+		{
+			OpenStackPositions[OpenStacks[k]] = INDEX_NONE;
+		}
+		OpenStacks.RemoveAt(0, Front, EAllowShrinking::No);
+		OpenStacks.SetNum(FMath::Max(0, Back - Front + 1), EAllowShrinking::No);
+		for (int32 k = 0; k < OpenStacks.Num(); ++k)
+		{
+			OpenStackPositions[OpenStacks[k]] = k;
+		}
+	}
+
+	// Total quantity (and weight) is unchanged, so emptied slots just leave the grid
+	for (const FGuid& InstanceId : EmptiedSlots)
+	{
+		const int32 ItemIndex = FindItemIndex(InstanceId);
+		ClearGridCells(ItemIndex);
+		RemoveItemSlotAt(ItemIndex);
+	}
+
+	if (EmptiedSlots.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[InventorySystem] MergeAllStacks freed %d slots"), EmptiedSlots.Num());
+		NotifyInventoryChanged();
+	}
+
+	return EmptiedSlots.Num();
+}
+
+bool UInventorySystem::RotateItem(FGuid InstanceId)
+{
+	const int32 ItemIndex = FindItemIndex(InstanceId);
+	if (ItemIndex == INDEX_NONE || !ItemList.Items[ItemIndex].IsPlacedInGrid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] RotateItem failed: Item not found or not placed"));
+		return false;
+	}
+
+	FItemSlot& Item = ItemList.Items[ItemIndex];
+	ClearGridCells(ItemIndex);
+
+	// Rotated size is the current size transposed
+	if (!Occupancy.IsFree(Item.GridRow, Item.GridCol, Item.GetGridHeight(), Item.GetGridWidth()))
+	{
+		OccupyGridCells(ItemIndex);
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] RotateItem failed: No room at (%d, %d)"), Item.GridRow, Item.GridCol);
+		return false;
+	}
+
+	Item.bRotated = !Item.bRotated;
+	OccupyGridCells(ItemIndex);
+	MarkItemDirty(ItemIndex);
+
+	NotifyInventoryChanged();
+	return true;
+}
+
+bool UInventorySystem::RemoveItem(FGuid InstanceId)
+{
+	// Find item by InstanceId
+	int32 ItemIndex = FindItemIndex(InstanceId);
+
 	if (ItemIndex == INDEX_NONE)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] RemoveItem failed: Item not found"));
 		return false;
 	}
 
-	FItemSlot& Item = Items[ItemIndex];
-
 	// Clear grid cells
-	ClearGridCells(Item);
-
-	// Update weight
-	CurrentWeight -= Item.GetTotalWeight();
+	ClearGridCells(ItemIndex);
 
 	// Remove from array
-	Items.RemoveAt(ItemIndex);
+	const float RemovedWeight = ItemList.Items[ItemIndex].GetTotalWeight();
+	RemoveItemSlotAt(ItemIndex);
+
+	// Update weight
+	ApplyWeightDelta(-RemovedWeight);
 
 	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Removed item, Weight: %.2f/%.2f"), CurrentWeight, MaxWeight);
 
+	NotifyInventoryChanged();
+	return true;
+}
+
+bool UInventorySystem::RemoveItemQuantity(FGuid InstanceId, int32 Amount)
+{
+	const int32 ItemIndex = FindItemIndex(InstanceId);
+	if (ItemIndex == INDEX_NONE || Amount <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] RemoveItemQuantity failed: Item not found or invalid Amount"));
+		return false;
+	}
+
+	FItemSlot& Item = ItemList.Items[ItemIndex];
+	if (Amount >= Item.Quantity)
+	{
+		return RemoveItem(InstanceId);
+	}
+
+	const int32 Removed = Item.RemoveQuantity(Amount);
+	ApplyWeightDelta(-Item.Footprint.UnitWeight * Removed);
+	UpdateOpenStack(ItemIndex);
+	MarkItemDirty(ItemIndex);
+
+	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Removed %d from stack (Remaining: %d), Weight: %.2f/%.2f"),
+		Removed, Item.Quantity, CurrentWeight, MaxWeight);
+
+	NotifyInventoryChanged();
 	return true;
 }
 
 bool UInventorySystem::MoveItem(FGuid InstanceId, int32 GridRow, int32 GridCol)
 {
 	// Find the item to move
-	FItemSlot* ItemToMove = FindItem(InstanceId);
-	if (!ItemToMove)
+	const int32 ItemIndex = FindItemIndex(InstanceId);
+	if (ItemIndex == INDEX_NONE)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] MoveItem failed: Item not found"));
 		return false;
 	}
 
+	FItemSlot* ItemToMove = &ItemList.Items[ItemIndex];
 	UItemData* ItemData = ItemToMove->GetItemData();
 	if (!ItemData)
 	{
@@ -203,13 +646,13 @@ bool UInventorySystem::MoveItem(FGuid InstanceId, int32 GridRow, int32 GridCol)
 	int32 OldCol = ItemToMove->GridCol;
 
 	// Clear the old grid cells
-	ClearGridCells(*ItemToMove);
+	ClearGridCells(ItemIndex);
 
-	// Check if item can be placed at new position
-	if (!CanPlaceItem(ItemData, GridRow, GridCol))
+	// Check if item can be placed at new position (keeping its current rotation)
+	if (!Occupancy.IsFree(GridRow, GridCol, ItemToMove->GetGridWidth(), ItemToMove->GetGridHeight()))
 	{
 		// Restore old grid cells if move failed
-		OccupyGridCells(*ItemToMove);
+		OccupyGridCells(ItemIndex);
 		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] MoveItem failed: Cannot place item at (%d, %d)"), GridRow, GridCol);
 		return false;
 	}
@@ -219,20 +662,20 @@ bool UInventorySystem::MoveItem(FGuid InstanceId, int32 GridRow, int32 GridCol)
 	ItemToMove->GridCol = GridCol;
 	UE_LOG(LogTemp, Warning, TEXT("Grid Row: %d, Grid Col: %d"), GridRow, GridCol);
 	// Occupy new grid cells
-	OccupyGridCells(*ItemToMove);
+	OccupyGridCells(ItemIndex);
+	MarkItemDirty(ItemIndex);
 
 	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Moved item '%s' from (%d, %d) to (%d, %d)"),
 		*ItemData->ItemName.ToString(), OldRow, OldCol, GridRow, GridCol);
 
+	NotifyInventoryChanged();
 	return true;
 }
 
 FItemSlot* UInventorySystem::FindItem(FGuid InstanceId)
 {
-	return Items.FindByPredicate([&](const FItemSlot& Slot)
-	{
-		return Slot.InstanceId == InstanceId;
-	});
+	const int32 ItemIndex = FindItemIndex(InstanceId);
+	return ItemIndex != INDEX_NONE ? &ItemList.Items[ItemIndex] : nullptr;
 }
 
 bool UInventorySystem::FindItemCopy(FGuid InstanceId, FItemSlot& OutItem)
@@ -253,21 +696,203 @@ bool UInventorySystem::FindEmptySpot(UItemData* ItemData, int32& OutRow, int32&
 		return false;
 	}
 
-	// Try to find an empty spot by scanning the grid
-	for (int32 Row = 0; Row <= RowCapacity - ItemData->GridHeight; ++Row)
+	// First-fit, row-major (bitmask search over the occupancy rows)
+	return Occupancy.FindFirstFit(ItemData->GridWidth, ItemData->GridHeight, OutRow, OutCol);
+}
+
+void UInventorySystem::PreloadItemData(const TArray<TSoftObjectPtr<UItemData>>& ItemAssets, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const TSoftObjectPtr<UItemData>& Asset : ItemAssets)
+	{
+		// Skip assets that are already in memory
+		if (!Asset.IsNull() && !Asset.IsValid())
+		{
+			PathsToLoad.AddUnique(Asset.ToSoftObjectPath());
+		}
+	}
+
+	if (PathsToLoad.IsEmpty())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToLoad), OnLoaded);
+}
+
+void UInventorySystem::WriteSaveData(FInventorySaveData& OutData) const
+{
+	OutData.Slots.Reserve(OutData.Slots.Num() + ItemList.Items.Num());
+	for (const FItemSlot& Item : ItemList.Items)
+	{
+		const int32 AssetIndex = OutData.FindOrAddAsset(Item.GetItemData());
+		if (AssetIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] WriteSaveData: Slot %s has no primary asset id, skipped"), *Item.InstanceId.ToString());
+			continue;
+		}
+
+		FInventorySaveData::FSlotRecord& Record = OutData.Slots.AddDefaulted_GetRef();
+		Record.AssetIndex = AssetIndex;
+		Record.GridRow = Item.GridRow;
+		Record.GridCol = Item.GridCol;
+		Record.bRotated = Item.bRotated;
+		Record.Quantity = Item.Quantity;
+		Record.Durability = Item.Durability;
+	}
+}
+
+void UInventorySystem::ApplySaveData(const FInventorySaveData& Data)
+{
+	// Clients keep the replicated list; loading here would append slots the server never sees
+	if (GetOwner() && !GetOwner()->HasAuthority())
 	{
-		for (int32 Col = 0; Col <= ColCapacity - ItemData->GridWidth; ++Col)
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] ApplySaveData ignored without authority"));
+		return;
+	}
+
+	InitializeGrid();
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	ItemList.Items.Reserve(Data.Slots.Num());
+	for (const FInventorySaveData::FSlotRecord& Record : Data.Slots)
+	{
+		UItemData* ItemData = AssetManager.GetPrimaryAssetObject<UItemData>(Data.Assets[Record.AssetIndex]);
+		if (!ItemData)
 		{
-			if (CanPlaceItem(ItemData, Row, Col))
+			UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] ApplySaveData: %s is not loaded, slot dropped"), *Data.Assets[Record.AssetIndex].ToString());
+			continue;
+		}
+
+		FItemSlot NewSlot(ItemData, Record.Quantity);
+		NewSlot.bRotated = Record.bRotated;
+		NewSlot.Durability = Record.Durability;
+
+		const int32 Width = Record.bRotated ? ItemData->GridHeight : ItemData->GridWidth;
+		const int32 Height = Record.bRotated ? ItemData->GridWidth : ItemData->GridHeight;
+		if (Occupancy.IsFree(Record.GridRow, Record.GridCol, Width, Height))
+		{
+			NewSlot.GridRow = Record.GridRow;
+			NewSlot.GridCol = Record.GridCol;
+		}
+
+		OccupyGridCells(AddItemSlot(NewSlot));
+	}
+
+	RecalculateWeight();
+
+	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Loaded %d items, Weight: %.2f/%.2f"), ItemList.Items.Num(), CurrentWeight, MaxWeight);
+
+	NotifyInventoryChanged();
+}
+
+float UInventorySystem::GetPackDensity() const
+{
+	const int32 TotalCells = RowCapacity * ColCapacity;
+	return TotalCells > 0 ? static_cast<float>(Occupancy.GetOccupiedCount()) / TotalCells : 0.0f;
+}
+
+void UInventorySystem::RunNetBenchmark(UItemData* ItemData, int32 NumFrames)
+{
+	UWorld* World = GetWorld();
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (!ItemData || !NetDriver || !NetDriver->IsServer() || NetDriver->ClientConnections.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] Net benchmark needs item data and a listen server with a client connected"));
+		return;
+	}
+
+	struct FNetBenchmarkState
+	{
+		int32 NumFrames = 0;
+		int32 Frame = 0;
+		double PhaseStartTime = 0.0;
+		int64 PhaseStartBytes = 0;
+		double IdleBytesPerSecond = 0.0;
+		TArray<FGuid> AddedIds;
+	};
+
+	TSharedRef<FNetBenchmarkState> State = MakeShared<FNetBenchmarkState>();
+	State->NumFrames = FMath::Max(NumFrames, 1);
+
+	TWeakObjectPtr<UInventorySystem> WeakThis(this);
+	TWeakObjectPtr<UItemData> WeakItemData(ItemData);
+	TWeakObjectPtr<UNetDriver> WeakNetDriver(NetDriver);
+
+	// Bytes sent to every client so far (includes all actors, so the idle phase is the baseline)
+	auto GetBytesSent = [WeakNetDriver]()
+	{
+		int64 Bytes = 0;
+		if (UNetDriver* Driver = WeakNetDriver.Get())
+		{
+			for (const UNetConnection* Connection : Driver->ClientConnections)
 			{
-				OutRow = Row;
-				OutCol = Col;
-				return true;
+				Bytes += Connection ? static_cast<int64>(Connection->OutTotalBytes) : 0;
 			}
 		}
-	}
+		return Bytes;
+	};
 
-	return false;
+	State->PhaseStartTime = FPlatformTime::Seconds();
+	State->PhaseStartBytes = GetBytesSent();
+
+	TSharedRef<TFunction<void()>> Step = MakeShared<TFunction<void()>>();
+	*Step = [WeakThis, WeakItemData, State, GetBytesSent, WeakStep = TWeakPtr<TFunction<void()>>(Step)]()
+	{
+		UInventorySystem* Inventory = WeakThis.Get();
+		UItemData* Data = WeakItemData.Get();
+		if (!Inventory || !Data)
+		{
+			return;
+		}
+
+		const int32 Frame = State->Frame++;
+		if (Frame == State->NumFrames)
+		{
+			// Idle phase done: record the baseline rate and start picking up
+			const double Now = FPlatformTime::Seconds();
+			State->IdleBytesPerSecond = (GetBytesSent() - State->PhaseStartBytes) / FMath::Max(Now - State->PhaseStartTime, UE_SMALL_NUMBER);
+			State->PhaseStartTime = Now;
+			State->PhaseStartBytes = GetBytesSent();
+		}
+
+		if (Frame >= State->NumFrames && Frame < State->NumFrames * 2)
+		{
+			// Always a new slot (no stacking), so the pickup is one added array element and can be undone
+			int32 Row, Col;
+			if (Inventory->FindEmptySpot(Data, Row, Col) && Inventory->AddItem(Data, Row, Col))
+			{
+				State->AddedIds.Add(Inventory->GetItems().Last().InstanceId);
+			}
+		}
+
+		// One extra idle phase after the pickups lets the last deltas go out before measuring
+		if (Frame < State->NumFrames * 3)
+		{
+			if (TSharedPtr<TFunction<void()>> Next = WeakStep.Pin())
+			{
+				Inventory->GetWorld()->GetTimerManager().SetTimerForNextTick([Next]() { (*Next)(); });
+			}
+			return;
+		}
+
+		const double Elapsed = FPlatformTime::Seconds() - State->PhaseStartTime;
+		const double ExtraBytes = (GetBytesSent() - State->PhaseStartBytes) - State->IdleBytesPerSecond * Elapsed;
+		const int32 NumPickups = State->AddedIds.Num();
+
+		UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Net benchmark: %d pickups into %d items, %.0f bytes over the idle baseline (%.1f bytes/pickup, idle %.0f bytes/s)"),
+			NumPickups, Inventory->GetItems().Num() - NumPickups, ExtraBytes,
+			NumPickups > 0 ? ExtraBytes / NumPickups : 0.0, State->IdleBytesPerSecond);
+
+		for (const FGuid& Id : State->AddedIds)
+		{
+			Inventory->RemoveItem(Id);
+		}
+	};
+
+	// Each scheduled tick holds Step; Step itself only holds a weak reference, so the chain frees itself when it stops
+	World->GetTimerManager().SetTimerForNextTick([Step]() { (*Step)(); });
 }
 
 //==============================================================================
@@ -276,17 +901,31 @@ bool UInventorySystem::FindEmptySpot(UItemData* ItemData, int32& OutRow, int32&
 
 void UInventorySystem::InitializeGrid()
 {
-	int32 TotalCells = RowCapacity * ColCapacity;
-	GridCells.SetNum(TotalCells);
+	if (ColCapacity > FInventoryOccupancyGrid::MaxColumns)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] ColCapacity %d exceeds %d, clamping"), ColCapacity, FInventoryOccupancyGrid::MaxColumns);
+		ColCapacity = FInventoryOccupancyGrid::MaxColumns;
+	}
 
-	// Initialize all cells with invalid GUIDs (empty)
-	for (int32 i = 0; i < TotalCells; ++i)
+	// Clients don't own the item list: keep whatever has replicated and rebuild the grid around it (async item data load)
+	if (GetOwner() && !GetOwner()->HasAuthority())
 	{
-		GridCells[i].Invalidate();
+		OnItemsReplicated();
+		return;
 	}
 
+	int32 TotalCells = RowCapacity * ColCapacity;
+
+	// Initialize all cells as empty
+	GridCells.Init(INDEX_NONE, TotalCells);
+	Occupancy.Init(RowCapacity, ColCapacity);
+
 	CurrentWeight = 0.0f;
-	Items.Empty();
+	ItemList.Items.Empty();
+	ItemList.MarkArrayDirty();
+	ItemIndexById.Reset();
+	OpenStacksByItem.Reset();
+	OpenStackPositions.Reset();
 
 	UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Grid initialized: %dx%d (%d cells)"), RowCapacity, ColCapacity, TotalCells);
 }
@@ -308,15 +947,182 @@ FItemSlot* UInventorySystem::GetItemAtCell(int32 Row, int32 Col)
 		return nullptr;
 	}
 
-	int32 Index = GetGridIndex(Row, Col);
-	FGuid ItemId = GridCells[Index];
+	int32 ItemIndex = GridCells[GetGridIndex(Row, Col)];
+	return ItemList.Items.IsValidIndex(ItemIndex) ? &ItemList.Items[ItemIndex] : nullptr;
+}
+
+void UInventorySystem::MarkItemDirty(int32 ItemIndex)
+{
+	ItemList.MarkItemDirty(ItemList.Items[ItemIndex]);
+}
 
-	if (!ItemId.IsValid())
+void UInventorySystem::RebuildDerivedState()
+{
+	GridCells.Init(INDEX_NONE, RowCapacity * ColCapacity);
+	Occupancy.Init(RowCapacity, ColCapacity);
+	ItemIndexById.Reset();
+	OpenStacksByItem.Reset();
+	OpenStackPositions.Init(INDEX_NONE, ItemList.Items.Num());
+
+	// Clients resolve only what is in memory; OnItemsReplicated streams the rest in and rebuilds again
+	const bool bAllowBlockingLoad = !GetOwner() || GetOwner()->HasAuthority();
+
+	for (int32 ItemIndex = 0; ItemIndex < ItemList.Items.Num(); ++ItemIndex)
 	{
-		return nullptr;
+		FItemSlot& Item = ItemList.Items[ItemIndex];
+		Item.ResolveItemData(bAllowBlockingLoad);
+
+		ItemIndexById.Add(Item.InstanceId, ItemIndex);
+		UpdateOpenStack(ItemIndex);
+		OccupyGridCells(ItemIndex);
+	}
+
+	RecalculateWeight();
+}
+
+void UInventorySystem::NotifyInventoryChanged()
+{
+	OnInventoryChanged.Broadcast();
+}
+
+int32 UInventorySystem::StackIntoExisting(UItemData* ItemData, int32 Quantity)
+{
+	if (!ItemData || !ItemData->bStackable)
+	{
+		return Quantity;
+	}
+
+	TArray<int32>* OpenStacks = OpenStacksByItem.Find(ItemData);
+	if (!OpenStacks)
+	{
+		return Quantity;
+	}
+
+	int32 RemainingQuantity = Quantity;
+
+	// Fill open stacks from the back of the list, so full ones pop off in O(1)
+	while (RemainingQuantity > 0 && OpenStacks->Num() > 0)
+	{
+		const int32 SlotIndex = OpenStacks->Last();
+		FItemSlot& Slot = ItemList.Items[SlotIndex];
+		int32 CanAddNum = FMath::Min(RemainingQuantity, ItemData->MaxStackSize - Slot.Quantity);
+		Slot.Quantity += CanAddNum;
+		RemainingQuantity -= CanAddNum;
+		MarkItemDirty(SlotIndex);
+		ApplyWeightDelta(ItemData->GetTotalWeight(CanAddNum));
+
+		UE_LOG(LogTemp, Log, TEXT("[InventorySystem] Stacked %d items (Remaining: %d)"), CanAddNum, RemainingQuantity);
+
+		if (Slot.Quantity >= ItemData->MaxStackSize)
+		{
+			RemoveOpenStack(SlotIndex);
+		}
+	}
+
+	return RemainingQuantity;
+}
+
+bool UInventorySystem::FindBestFitSpot(const FItemFootprint& Footprint, bool bAllowRotation, int32& OutRow, int32& OutCol, bool& bOutRotated) const
+{
+	int32 Score = -1;
+	bool bFound = Occupancy.FindBestFit(Footprint.GridWidth, Footprint.GridHeight, OutRow, OutCol, Score);
+	bOutRotated = false;
+
+	// Square items look the same rotated
+	if (bAllowRotation && Footprint.GridWidth != Footprint.GridHeight)
+	{
+		int32 RotRow, RotCol, RotScore;
+		if (Occupancy.FindBestFit(Footprint.GridHeight, Footprint.GridWidth, RotRow, RotCol, RotScore) && RotScore > Score)
+		{
+			OutRow = RotRow;
+			OutCol = RotCol;
+			bOutRotated = true;
+			bFound = true;
+		}
 	}
 
-	return FindItem(ItemId);
+	return bFound;
+}
+
+int32 UInventorySystem::FindItemIndex(const FGuid& InstanceId) const
+{
+	const int32* Found = ItemIndexById.Find(InstanceId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 UInventorySystem::AddItemSlot(const FItemSlot& NewSlot)
+{
+	const int32 NewIndex = ItemList.Items.Add(NewSlot);
+	OpenStackPositions.Add(INDEX_NONE);
+	ItemIndexById.Add(NewSlot.InstanceId, NewIndex);
+	MarkItemDirty(NewIndex);
+
+	// Capture the footprint now so grid/weight/stack operations never go through the soft pointer
+	if (!ItemList.Items[NewIndex].ResolveItemData())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySystem] Slot %s has no resolvable ItemData"), *NewSlot.InstanceId.ToString());
+	}
+
+	UpdateOpenStack(NewIndex);
+	return NewIndex;
+}
+
+void UInventorySystem::RemoveItemSlotAt(int32 ItemIndex)
+{
+	ItemIndexById.Remove(ItemList.Items[ItemIndex].InstanceId);
+	RemoveOpenStack(ItemIndex);
+
+	// Swap with the last item, then re-point the moved item's index, grid cells and open stack entry
+	ItemList.Items.RemoveAtSwap(ItemIndex);
+	OpenStackPositions.RemoveAtSwap(ItemIndex, 1, EAllowShrinking::No);
+	ItemList.MarkArrayDirty();
+	if (ItemList.Items.IsValidIndex(ItemIndex))
+	{
+		ItemIndexById.Add(ItemList.Items[ItemIndex].InstanceId, ItemIndex);
+		OccupyGridCells(ItemIndex);
+
+		const int32 Position = OpenStackPositions[ItemIndex];
+		if (Position != INDEX_NONE)
+		{
+			OpenStacksByItem.FindChecked(ItemList.Items[ItemIndex].ResolvedItemData)[Position] = ItemIndex;
+		}
+	}
+}
+
+void UInventorySystem::UpdateOpenStack(int32 ItemIndex)
+{
+	const FItemSlot& Item = ItemList.Items[ItemIndex];
+	if (!Item.IsResolved() || !Item.Footprint.bStackable)
+	{
+		return;
+	}
+
+	const bool bHasRoom = Item.Quantity < Item.Footprint.MaxStackSize;
+	if (!bHasRoom)
+	{
+		RemoveOpenStack(ItemIndex);
+	}
+	else if (OpenStackPositions[ItemIndex] == INDEX_NONE)
+	{
+		OpenStackPositions[ItemIndex] = OpenStacksByItem.FindOrAdd(Item.ResolvedItemData).Add(ItemIndex);
+	}
+}
+
+void UInventorySystem::RemoveOpenStack(int32 ItemIndex)
+{
+	const int32 Position = OpenStackPositions[ItemIndex];
+	if (Position == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32>& OpenStacks = OpenStacksByItem.FindChecked(ItemList.Items[ItemIndex].ResolvedItemData);
+	OpenStacks.RemoveAtSwap(Position, 1, EAllowShrinking::No);
+	if (OpenStacks.IsValidIndex(Position))
+	{
+		OpenStackPositions[OpenStacks[Position]] = Position;
+	}
+	OpenStackPositions[ItemIndex] = INDEX_NONE;
 }
 
 bool UInventorySystem::GetItemAtCellCopy(int32 Row, int32 Col, FItemSlot& OutItem)
@@ -330,66 +1136,84 @@ bool UInventorySystem::GetItemAtCellCopy(int32 Row, int32 Col, FItemSlot& OutIte
 	return false;
 }
 
-void UInventorySystem::OccupyGridCells(const FItemSlot& Item)
+void UInventorySystem::OccupyGridCells(int32 ItemIndex)
 {
-	if (!Item.IsPlacedInGrid())
-	{
-		return;
-	}
-
-	UItemData* Data = Item.GetItemData();
-	if (!Data)
+	const FItemSlot& Item = ItemList.Items[ItemIndex];
+	if (!Item.IsPlacedInGrid() || !Item.IsResolved())
 	{
 		return;
 	}
 
 	// Mark all cells occupied by this item
-	for (int32 r = 0; r < Data->GridHeight; ++r)
+	for (int32 r = 0; r < Item.GetGridHeight(); ++r)
 	{
-		for (int32 c = 0; c < Data->GridWidth; ++c)
+		for (int32 c = 0; c < Item.GetGridWidth(); ++c)
 		{
 			int32 Row = Item.GridRow + r;
 			int32 Col = Item.GridCol + c;
 			int32 Index = GetGridIndex(Row, Col);
 
-			GridCells[Index] = Item.InstanceId;
+			GridCells[Index] = ItemIndex;
 		}
 	}
+
+	Occupancy.Mark(Item.GridRow, Item.GridCol, Item.GetGridWidth(), Item.GetGridHeight());
 }
 
-void UInventorySystem::ClearGridCells(const FItemSlot& Item)
+void UInventorySystem::ClearGridCells(int32 ItemIndex)
 {
-	if (!Item.IsPlacedInGrid())
-	{
-		return;
-	}
-
-	UItemData* Data = Item.GetItemData();
-	if (!Data)
+	const FItemSlot& Item = ItemList.Items[ItemIndex];
+	if (!Item.IsPlacedInGrid() || !Item.IsResolved())
 	{
 		return;
 	}
 
 	// Clear all cells occupied by this item
-	for (int32 r = 0; r < Data->GridHeight; ++r)
+	for (int32 r = 0; r < Item.GetGridHeight(); ++r)
 	{
-		for (int32 c = 0; c < Data->GridWidth; ++c)
+		for (int32 c = 0; c < Item.GetGridWidth(); ++c)
 		{
 			int32 Row = Item.GridRow + r;
 			int32 Col = Item.GridCol + c;
 			int32 Index = GetGridIndex(Row, Col);
 
-			GridCells[Index].Invalidate();
+			GridCells[Index] = INDEX_NONE;
 		}
 	}
+
+	Occupancy.Clear(Item.GridRow, Item.GridCol, Item.GetGridWidth(), Item.GetGridHeight());
 }
 
-void UInventorySystem::RecalculateWeight()
+void UInventorySystem::ApplyWeightDelta(float Delta)
 {
-	CurrentWeight = 0.0f;
+	// An empty inventory weighs nothing; snapping here keeps float drift from accumulating
+	CurrentWeight = ItemList.Items.IsEmpty() ? 0.0f : CurrentWeight + Delta;
 
-	for (const FItemSlot& Item : Items)
+	VerifyWeight();
+}
+
+float UInventorySystem::ComputeTotalWeight() const
+{
+	float TotalWeight = 0.0f;
+
+	for (const FItemSlot& Item : ItemList.Items)
 	{
-		CurrentWeight += Item.GetTotalWeight();
+		TotalWeight += Item.GetTotalWeight();
 	}
+
+	return TotalWeight;
+}
+
+void UInventorySystem::RecalculateWeight()
+{
+	CurrentWeight = ComputeTotalWeight();
+}
+
+void UInventorySystem::VerifyWeight() const
+{
+#if DO_GUARD_SLOW
+	const float Recomputed = ComputeTotalWeight();
+	ensureMsgf(FMath::IsNearlyEqual(CurrentWeight, Recomputed, 0.01f),
+		TEXT("[InventorySystem] Incremental weight %.3f differs from recomputed %.3f"), CurrentWeight, Recomputed);
+#endif
 }
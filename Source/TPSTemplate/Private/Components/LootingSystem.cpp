@@ -55,6 +55,8 @@ void ULootingSystem::GenerateLoot()
 		LootTable->MaxDropCount
 	);
 
+	// Roll every drop first, then add them to the container in one transaction
+	TArray<FItemAddRequest, TInlineAllocator<8>> Drops;
 	for (int32 i = 0; i < DropCount; ++i)
 	{
 		const FLootItemEntry* Selected = SelectByWeight(ValidEntries);
@@ -62,9 +64,11 @@ void ULootingSystem::GenerateLoot()
 			continue;
 
 		// TODO: Cacluate Item Quantity
-		OwnerIS->TryAddItemEmptySpot(Selected->ItemData);
-		UE_LOG(LogTemp, Error, TEXT("Selected->ItemData: %s"), *Selected->ItemData->ItemName.ToString());
+		Drops.Emplace(Selected->ItemData, 1);
 	}
+
+	const FItemAddBatchResult Result = OwnerIS->AddItems(Drops);
+	UE_LOG(LogTemp, Log, TEXT("GenerateLoot: %d/%d drops added"), Result.NumAdded, Drops.Num());
 }
 
 const FLootItemEntry* ULootingSystem::SelectByWeight(TArray<const FLootItemEntry*> Entries)
@@ -8,11 +8,74 @@
 #include "Kismet/GameplayStatics.h"
 #include "Components/SceneComponent.h"
 #include "Perception/AISense_Hearing.h"
+#include "Subsystems/NoiseEventSubsystem.h"
+#include "TPSTemplate.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("MuzzleFlash Activations"), STAT_MuzzleFlashActivations, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MuzzleFlash Component Allocations"), STAT_MuzzleFlashAllocations, STATGROUP_TPSTemplate);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("MuzzleFlash Allocations/s"), STAT_MuzzleFlashAllocationsPerSecond, STATGROUP_TPSTemplate);
+
+namespace
+{
+	/** Muzzle flash allocation rate over a one second window (all weapons, game thread only) */
+	struct FMuzzleFlashAllocationRate
+	{
+		double WindowStart = 0.0;
+		int32 WindowAllocations = 0;
+		float LastRate = 0.0f;
+
+		void Record(bool bAllocated)
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (WindowStart == 0.0)
+			{
+				WindowStart = Now;
+			}
+			WindowAllocations += bAllocated ? 1 : 0;
+
+			const double Elapsed = Now - WindowStart;
+			if (Elapsed >= 1.0)
+			{
+				LastRate = static_cast<float>(WindowAllocations / Elapsed);
+				WindowStart = Now;
+				WindowAllocations = 0;
+			}
+			SET_FLOAT_STAT(STAT_MuzzleFlashAllocationsPerSecond, LastRate);
+		}
+	};
+
+	FMuzzleFlashAllocationRate MuzzleFlashAllocationRate;
+
+	/** World-pool components seen so far; a component not in here was newly allocated by the pool */
+	TSet<TObjectKey<UNiagaraComponent>> KnownPooledMuzzleFlashes;
+
+	/** Size at which KnownPooledMuzzleFlashes drops components that are gone (world torn down, pool trimmed) */
+	int32 KnownPooledMuzzleFlashesPruneSize = 64;
+
+	void AddKnownPooledMuzzleFlash(UNiagaraComponent* Component, bool& bOutAlreadyKnown)
+	{
+		KnownPooledMuzzleFlashes.Add(Component, &bOutAlreadyKnown);
+		if (KnownPooledMuzzleFlashes.Num() < KnownPooledMuzzleFlashesPruneSize)
+		{
+			return;
+		}
+
+		for (auto It = KnownPooledMuzzleFlashes.CreateIterator(); It; ++It)
+		{
+			if (!IsValid(It->ResolveObjectPtr()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+		KnownPooledMuzzleFlashesPruneSize = FMath::Max(64, KnownPooledMuzzleFlashes.Num() * 2);
+	}
+}
 
 // Sets default values for this component's properties
 UWeaponSystem::UWeaponSystem()
 {
 	PrimaryComponentTick.bCanEverTick = false;
+	MuzzleFlashComponent = nullptr;
 }
 
 bool UWeaponSystem::FireCheck(int32 AmmoCount)
@@ -27,7 +90,7 @@ void UWeaponSystem::FireFX(USoundBase* Sound, FVector Location, USoundAttenuatio
 {
 	if (!Sound)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UWeaponSystem::FireFX Sound is null"));
+		UE_LOG(LogTPSWeapon, Warning, TEXT("UWeaponSystem::FireFX Sound is null"));
 		return;
 	}
 
@@ -43,12 +106,20 @@ void UWeaponSystem::FireFX(USoundBase* Sound, FVector Location, USoundAttenuatio
 		ConcurrencySettings     // Concurrency settings
 	);
 
-	UAISense_Hearing::ReportNoiseEvent(
-		GetWorld(),
-		Location,
-		1.f,
-		CharacterRef
-	);
+	// Full-auto fire is merged into one hearing event per window and skipped when no enemy is in range
+	if (UNoiseEventSubsystem* NoiseEvents = GetWorld()->GetSubsystem<UNoiseEventSubsystem>())
+	{
+		NoiseEvents->ReportNoise(CharacterRef, Location, 1.f);
+	}
+	else
+	{
+		UAISense_Hearing::ReportNoiseEvent(
+			GetWorld(),
+			Location,
+			1.f,
+			CharacterRef
+		);
+	}
 }
 
 void UWeaponSystem::EmptyFX(USoundBase* Sound)
@@ -60,31 +131,92 @@ void UWeaponSystem::EmptyFX(USoundBase* Sound)
 	);
 }
 
-void UWeaponSystem::MuzzleVFX(UNiagaraSystem* SystemTemplate, USceneComponent* AttachToComponent)
+void UWeaponSystem::MuzzleVFX(UNiagaraSystem* SystemTemplate, USceneComponent* AttachToComponent, FName SocketName, EMuzzleFlashPoolMode PoolMode)
 {
 	if (!SystemTemplate || !AttachToComponent)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MuzzleVFX: SystemTemplate or AttachToComponent is null"));
+		UE_LOG(LogTPSWeapon, Warning, TEXT("MuzzleVFX: SystemTemplate or AttachToComponent is null"));
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_MuzzleFlashActivations);
+
+	// Persistent: one component per weapon, restarted every shot
+	if (PoolMode == EMuzzleFlashPoolMode::Persistent)
+	{
+		const bool bAllocated = !IsValid(MuzzleFlashComponent);
+		if (bAllocated)
+		{
+			MuzzleFlashComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(
+				SystemTemplate,
+				AttachToComponent,
+				SocketName,
+				FVector::ZeroVector,
+				FRotator::ZeroRotator,
+				EAttachLocation::SnapToTarget,
+				false,                   // Auto Destroy
+				false,                   // Auto Activate (activated below)
+				ENCPoolMethod::None,
+				true                     // Pre Cull Check
+			);
+			if (!MuzzleFlashComponent)
+			{
+				UE_LOG(LogTPSWeapon, Warning, TEXT("MuzzleVFX: Failed to spawn niagara component"));
+				return;
+			}
+			INC_DWORD_STAT(STAT_MuzzleFlashAllocations);
+		}
+		else
+		{
+			if (MuzzleFlashComponent->GetAsset() != SystemTemplate)
+			{
+				MuzzleFlashComponent->SetAsset(SystemTemplate);
+			}
+
+			// The weapon mesh or muzzle socket may have changed since the component was spawned
+			if (MuzzleFlashComponent->GetAttachParent() != AttachToComponent || MuzzleFlashComponent->GetAttachSocketName() != SocketName)
+			{
+				MuzzleFlashComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale, SocketName);
+			}
+		}
+
+		MuzzleFlashComponent->Activate(true);
+		MuzzleFlashAllocationRate.Record(bAllocated);
+		return;
+	}
+
+	const bool bWorldPool = PoolMode == EMuzzleFlashPoolMode::WorldPool;
 	UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(
 		SystemTemplate,           // 나이아가라 시스템 템플릿
 		AttachToComponent,       // 부착할 컴포넌트
-		NAME_None,               // 소켓 이름 (None으로 설정)
+		SocketName,              // 소켓 이름
 		FVector(0, 0, 0),        // 위치 오프셋
 		FRotator(0, 0, 0),       // 회전 오프셋
 		EAttachLocation::KeepRelativeOffset,  // 위치 타입
+		!bWorldPool,             // Auto Destroy (pooled components are released, not destroyed)
 		true,                    // Auto Activate
-		true,                    // Auto Destroy
-		ENCPoolMethod::None,     // Pooling Method
+		bWorldPool ? ENCPoolMethod::AutoRelease : ENCPoolMethod::None,
 		true                     // Pre Cull Check
 	);
 
 	if (!NiagaraComponent)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MuzzleVFX: Failed to spawn niagara component"));
+		UE_LOG(LogTPSWeapon, Warning, TEXT("MuzzleVFX: Failed to spawn niagara component"));
+		return;
+	}
+
+	bool bAllocated = true;
+	if (bWorldPool)
+	{
+		bool bAlreadyKnown = false;
+		AddKnownPooledMuzzleFlash(NiagaraComponent, bAlreadyKnown);
+		bAllocated = !bAlreadyKnown;
+	}
+	if (bAllocated)
+	{
+		INC_DWORD_STAT(STAT_MuzzleFlashAllocations);
 	}
+	MuzzleFlashAllocationRate.Record(bAllocated);
 }
 
 void UWeaponSystem::FireMontage(UAnimMontage* FireAnim)
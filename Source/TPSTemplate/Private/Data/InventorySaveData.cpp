@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/InventorySaveData.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 InventorySaveMagic = 0x49535054; // "TPSI"
+
+	/** Packed signed int for grid coordinates (-1 = not placed, stored as 0) */
+	void SerializeGridCoord(FArchive& Ar, int32& Value)
+	{
+		uint32 Packed = static_cast<uint32>(Value + 1);
+		Ar.SerializeIntPacked(Packed);
+		Value = static_cast<int32>(Packed) - 1;
+	}
+
+	void SerializePacked(FArchive& Ar, int32& Value)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(0, Value));
+		Ar.SerializeIntPacked(Packed);
+		Value = static_cast<int32>(Packed);
+	}
+
+	/**
+	 * Element count of a table; on load, rejects counts the rest of the archive cannot hold
+	 * (every element takes at least one byte) so a corrupt file cannot trigger a huge allocation
+	 */
+	bool SerializeCount(FArchive& Ar, int32& Count)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(0, Count));
+		Ar.SerializeIntPacked(Packed);
+		if (Ar.IsLoading())
+		{
+			const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+			if (Ar.IsError() || Packed > static_cast<uint32>(MAX_int32) || static_cast<int64>(Packed) > Remaining)
+			{
+				Ar.SetError();
+				return false;
+			}
+			Count = static_cast<int32>(Packed);
+		}
+		return true;
+	}
+
+	void SerializeAmmo(FArchive& Ar, FWeaponAmmoState& Ammo)
+	{
+		SerializePacked(Ar, Ammo.CurrentAmmo);
+		SerializePacked(Ar, Ammo.MaxAmmo);
+		SerializePacked(Ar, Ammo.ClipAmmo);
+		SerializePacked(Ar, Ammo.DifferentAmmo);
+		SerializePacked(Ar, Ammo.AmmoCount);
+	}
+}
+
+int32 FInventorySaveData::FindOrAddAsset(const UItemData* ItemData)
+{
+	if (!ItemData)
+	{
+		return INDEX_NONE;
+	}
+
+	const FPrimaryAssetId AssetId = ItemData->GetPrimaryAssetId();
+	if (!AssetId.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	return Assets.AddUnique(AssetId);
+}
+
+bool FInventorySaveData::Serialize(FArchive& Ar)
+{
+	uint32 Magic = InventorySaveMagic;
+	uint8 Version = static_cast<uint8>(EInventorySaveVersion::Latest);
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsError() || Magic != InventorySaveMagic || Version == 0 || Version > static_cast<uint8>(EInventorySaveVersion::Latest))
+	{
+		return false;
+	}
+
+	// Asset table: "Type:Name" strings, each written once
+	int32 NumAssets = Assets.Num();
+	if (!SerializeCount(Ar, NumAssets))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		Assets.SetNum(NumAssets);
+	}
+	for (FPrimaryAssetId& AssetId : Assets)
+	{
+		FString IdString = AssetId.ToString();
+		Ar << IdString;
+		if (Ar.IsLoading())
+		{
+			AssetId = FPrimaryAssetId(IdString);
+		}
+	}
+
+	// Inventory slots
+	int32 NumSlots = Slots.Num();
+	if (!SerializeCount(Ar, NumSlots))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		Slots.SetNum(NumSlots);
+	}
+	for (FSlotRecord& Slot : Slots)
+	{
+		SerializePacked(Ar, Slot.AssetIndex);
+		SerializeGridCoord(Ar, Slot.GridRow);
+		SerializeGridCoord(Ar, Slot.GridCol);
+		SerializePacked(Ar, Slot.Quantity);
+
+		uint8 Flags = Slot.bRotated ? 1 : 0;
+		uint8 Durability = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Slot.Durability, 0.0f, 1.0f) * 255.0f));
+		Ar << Flags;
+		Ar << Durability;
+		if (Ar.IsLoading())
+		{
+			Slot.bRotated = (Flags & 1) != 0;
+			Slot.Durability = Durability / 255.0f;
+		}
+	}
+
+	// Equipment
+	int32 NumEquipment = Equipment.Num();
+	if (!SerializeCount(Ar, NumEquipment))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		Equipment.SetNum(NumEquipment);
+	}
+	for (FEquipmentRecord& Record : Equipment)
+	{
+		uint8 Slot = static_cast<uint8>(Record.Slot);
+		uint8 bHasAmmo = Record.bHasAmmo ? 1 : 0;
+		Ar << Slot;
+		SerializePacked(Ar, Record.AssetIndex);
+		Ar << bHasAmmo;
+		if (bHasAmmo)
+		{
+			SerializeAmmo(Ar, Record.Ammo);
+		}
+		if (Ar.IsLoading())
+		{
+			Record.Slot = static_cast<EEquipmentSlot>(Slot);
+			Record.bHasAmmo = bHasAmmo != 0;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+bool FInventorySaveData::SaveToBytes(TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	return Serialize(Writer);
+}
+
+bool FInventorySaveData::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	// Load into a scratch record so a corrupt file leaves this one untouched
+	FInventorySaveData Loaded;
+	FMemoryReader Reader(Bytes);
+	if (!Loaded.Serialize(Reader) || Reader.IsError())
+	{
+		return false;
+	}
+
+	// Reject records pointing outside the asset table (truncated/corrupt file)
+	for (const FSlotRecord& Slot : Loaded.Slots)
+	{
+		if (!Loaded.Assets.IsValidIndex(Slot.AssetIndex))
+		{
+			return false;
+		}
+	}
+	for (const FEquipmentRecord& Record : Loaded.Equipment)
+	{
+		if (!Loaded.Assets.IsValidIndex(Record.AssetIndex))
+		{
+			return false;
+		}
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
@@ -17,6 +17,7 @@ UWeaponData::UWeaponData()
     // Fire Mode Data
     FireMode = EFireMode::SemiAuto;
     BurstAmount = 1;
+    BurstShotCount = 3;
     FireRate = 0.1f;  // 분당 발사 수
 
     // Ballistics
@@ -39,3 +40,16 @@ UWeaponData::UWeaponData()
     // Audio
     FireSound = nullptr;
 }
+
+int32 UWeaponData::GetShotsPerPress() const
+{
+    switch (FireMode)
+    {
+    case EFireMode::SemiAuto:
+        return 1;
+    case EFireMode::Burst:
+        return FMath::Max(BurstShotCount, 1);
+    default:
+        return 0;
+    }
+}
@@ -3,3 +3,109 @@
 
 #include "Enemy/AIC_Infector.h"
 
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Subsystems/FlowFieldSubsystem.h"
+#include "TimerManager.h"
+
+FPathFollowingRequestResult AAIC_Infector::MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath)
+{
+	const AActor* GoalActor = MoveRequest.IsMoveToActorRequest() ? MoveRequest.GetGoalActor() : nullptr;
+	UFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	const APawn* ControlledPawn = GetPawn();
+	if (!bUseFlowField || !GoalActor || !FlowFields || !ControlledPawn || !MoveRequest.IsUsingPathfinding())
+	{
+		return Super::MoveTo(MoveRequest, OutPath);
+	}
+
+	StopFlowPathRefresh();
+
+	TArray<FVector> PathPoints;
+	uint32 FieldVersion = 0;
+	if (!FlowFields->FindPathToTarget(GoalActor, ControlledPawn->GetActorLocation(), PathPoints, &FieldVersion))
+	{
+		return Super::MoveTo(MoveRequest, OutPath);
+	}
+
+	// The field already knows the way - hand the path straight to path following
+	FNavPathSharedPtr Path = MakeShareable(new FNavigationPath(PathPoints, nullptr));
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		Path->SetNavigationDataUsed(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate));
+	}
+	Path->MarkReady();
+
+	FPathFollowingRequestResult Result;
+	Result.MoveId = RequestMove(MoveRequest, Path);
+	Result.Code = Result.MoveId.IsValid() ? EPathFollowingRequestResult::RequestSuccessful : EPathFollowingRequestResult::Failed;
+
+	// The path ends where the goal was; keep it in step with the goal's field while the move runs
+	if (Result.MoveId.IsValid())
+	{
+		FlowPath = Path;
+		FlowMoveRequest = MoveRequest;
+		FlowGoal = GoalActor;
+		FlowFieldVersion = FieldVersion;
+		GetWorldTimerManager().SetTimer(FlowPathRefreshTimer, this, &AAIC_Infector::RefreshFlowPath, FlowPathRefreshInterval, true);
+	}
+
+	if (OutPath)
+	{
+		*OutPath = Path;
+	}
+	return Result;
+}
+
+void AAIC_Infector::RefreshFlowPath()
+{
+	const UPathFollowingComponent* PathFollowing = GetPathFollowingComponent();
+	const AActor* GoalActor = FlowGoal.Get();
+	const APawn* ControlledPawn = GetPawn();
+	UFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	if (!PathFollowing || PathFollowing->GetPath() != FlowPath || PathFollowing->GetStatus() == EPathFollowingStatus::Idle
+		|| !GoalActor || !ControlledPawn || !FlowFields)
+	{
+		// The move finished or was replaced
+		StopFlowPathRefresh();
+		return;
+	}
+
+	if (!FlowFields->IsPathStale(GoalActor, FlowFieldVersion))
+	{
+		return;
+	}
+
+	TArray<FVector> PathPoints;
+	if (!FlowFields->FindPathToTarget(GoalActor, ControlledPawn->GetActorLocation(), PathPoints, &FlowFieldVersion))
+	{
+		// Goal left the field's reach - let regular pathfinding take the move over
+		const FAIMoveRequest MoveRequest = FlowMoveRequest;
+		StopFlowPathRefresh();
+		Super::MoveTo(MoveRequest);
+		return;
+	}
+
+	// Path following picks the new points up from the update event, like a navmesh repath after the goal moved
+	TArray<FNavPathPoint>& Points = FlowPath->GetPathPoints();
+	Points.Reset(PathPoints.Num());
+	for (const FVector& Point : PathPoints)
+	{
+		Points.Emplace(Point);
+	}
+	FlowPath->DoneUpdating(ENavPathUpdateType::GoalMoved);
+}
+
+void AAIC_Infector::StopFlowPathRefresh()
+{
+	GetWorldTimerManager().ClearTimer(FlowPathRefreshTimer);
+	FlowPath.Reset();
+	FlowGoal.Reset();
+}
+
+void AAIC_Infector::OnUnPossess()
+{
+	StopFlowPathRefresh();
+
+	Super::OnUnPossess();
+}
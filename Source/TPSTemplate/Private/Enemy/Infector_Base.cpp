@@ -2,4 +2,18 @@
 
 
 #include "Enemy/Infector_Base.h"
+#include "Enemy/AIC_Infector.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+AInfector_Base::AInfector_Base()
+{
+	AIControllerClass = AAIC_Infector::StaticClass();
+
+	// Flow-field paths converge on the same cells; RVO keeps the swarm separated locally
+	if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+	{
+		Movement->bUseRVOAvoidance = true;
+		Movement->AvoidanceConsiderationRadius = 300.0f;
+	}
+}
 
@@ -6,6 +6,7 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Characters/Player_Base.h"
 #include "Slate/SGameLayerManager.h"
+#include "Subsystems/AIDirectorSubsystem.h"
 
 ATPSTemplate_AIController::ATPSTemplate_AIController()
 {
@@ -50,6 +51,11 @@ void ATPSTemplate_AIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 
+	// Stimuli are stored per sense ID; resolve them once instead of per stimulus
+	SightSenseID = UAISense::GetSenseID<UAISense_Sight>();
+	HearingSenseID = UAISense::GetSenseID<UAISense_Hearing>();
+	DamageSenseID = UAISense::GetSenseID<UAISense_Damage>();
+
 	if (AIPerception)
 	{
 		AIPerception->OnPerceptionUpdated.AddDynamic(this, &ATPSTemplate_AIController::OnPerceptionUpdated);
@@ -111,35 +117,206 @@ bool ATPSTemplate_AIController::CanSenseActor(AActor* Actor, ESenseType SenseTyp
 		return false;
 	}
 
-	FActorPerceptionBlueprintInfo Info;
-	AIPerception->GetActorsPerception(Actor, Info);
+	FAISenseID SenseID;
+	switch (SenseType)
+	{
+	case ESenseType::Sight:
+		SenseID = SightSenseID;
+		break;
+	case ESenseType::Hearing:
+		SenseID = HearingSenseID;
+		break;
+	case ESenseType::Damage:
+		SenseID = DamageSenseID;
+		break;
+	default:
+		return false;
+	}
+
+	const FAIStimulus* Stimulus = FindStimulus(Actor, SenseID);
+	if (Stimulus && Stimulus->WasSuccessfullySensed())
+	{
+		StimulusRef = *Stimulus;
+		return true;
+	}
+	return false;
+}
+
+const FAIStimulus* ATPSTemplate_AIController::FindStimulus(const AActor* Actor, FAISenseID SenseID) const
+{
+	if (!Actor || !AIPerception || !SenseID.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FActorPerceptionInfo* Info = AIPerception->GetActorInfo(*Actor);
+	if (!Info || !Info->LastSensedStimuli.IsValidIndex(SenseID))
+	{
+		return nullptr;
+	}
+
+	const FAIStimulus& Stimulus = Info->LastSensedStimuli[SenseID];
+	return Stimulus.IsValid() ? &Stimulus : nullptr;
+}
+
+void ATPSTemplate_AIController::BuildPerceptionBatch(const TArray<AActor*>& UpdateActors, FAIPerceptionBatch& Batch) const
+{
+	const UBlackboardComponent* BB = GetBlackboardComponent();
+	Batch.State = AIState;
+	Batch.bHasBlackboard = BB != nullptr;
+
+	const APawn* ControlledPawn = GetPawn();
+	if (!ControlledPawn)
+	{
+		return;
+	}
+	const FVector PawnLocation = ControlledPawn->GetActorLocation();
 
-	for (const FAIStimulus& Stimulus : Info.LastSensedStimuli)
+	for (AActor* Actor : UpdateActors)
 	{
-		// Stimulus의 실제 Sense 타입 확인
-		TSubclassOf<UAISense> SenseClass = UAIPerceptionSystem::GetSenseClassForStimulus(this, Stimulus);
+		APlayer_Base* Player = Cast<APlayer_Base>(Actor);
+		if (!Player)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Orange,
+				FString::Printf(TEXT("Actor %s is not Player_Base, skipping"), Actor ? *Actor->GetName() : TEXT("NULL")));
+			continue;
+		}
 
-		bool bIsCorrectSense = false;
-		if (SenseType == ESenseType::Sight && SenseClass == UAISense_Sight::StaticClass())
+		FAIPerceptionSnapshot& Snapshot = Batch.Snapshots.AddDefaulted_GetRef();
+		Snapshot.Actor = Player;
+		Snapshot.ActorLocation = Player->GetActorLocation();
+		Snapshot.Distance = FVector::Dist(PawnLocation, Snapshot.ActorLocation);
+
+		if (const FAIStimulus* Stimulus = FindStimulus(Player, SightSenseID))
+		{
+			Snapshot.Sight = *Stimulus;
+		}
+		if (const FAIStimulus* Stimulus = FindStimulus(Player, HearingSenseID))
 		{
-			bIsCorrectSense = true;
+			Snapshot.Hearing = *Stimulus;
 		}
-		else if (SenseType == ESenseType::Hearing && SenseClass == UAISense_Hearing::StaticClass())
+		if (const FAIStimulus* Stimulus = FindStimulus(Player, DamageSenseID))
 		{
-			bIsCorrectSense = true;
+			Snapshot.Damage = *Stimulus;
 		}
-		else if (SenseType == ESenseType::Damage && SenseClass == UAISense_Damage::StaticClass())
+	}
+}
+
+void ATPSTemplate_AIController::DecidePerception(FAIPerceptionBatch& Batch)
+{
+	// Track the state the replayed Handle*/SetStateAs* calls will leave behind (they only switch with a blackboard)
+	EAIState State = Batch.State;
+	auto AddAction = [&Batch](EAIPerceptionAction Type, const TWeakObjectPtr<AActor>& Actor, const FVector& Location)
+	{
+		Batch.Actions.Add({ Type, Actor, Location });
+	};
+	auto SensedSight = [&](const TWeakObjectPtr<AActor>& Actor)
+	{
+		AddAction(EAIPerceptionAction::SensedSight, Actor, FVector::ZeroVector);
+		if (Batch.bHasBlackboard && (State == EAIState::Passive || State == EAIState::Investigating))
+		{
+			State = EAIState::Attacking;
+		}
+	};
+
+	for (const FAIPerceptionSnapshot& Snapshot : Batch.Snapshots)
+	{
+		const float Distance = Snapshot.Distance;
+
+		// 시각 감지 체크
+		if (Snapshot.Sight.IsValid() && Snapshot.Sight.WasSuccessfullySensed())
+		{
+			// 성공적으로 시야에 들어옴 - 거리에 따른 반응
+			if (Distance < 300.f)
+			{
+				// 가까운 거리 - 즉시 공격
+				SensedSight(Snapshot.Actor);
+			}
+			else if (Distance < 800.f)
+			{
+				// 중간 거리 - 조사 또는 추적
+				if (State == EAIState::Passive)
+				{
+					AddAction(EAIPerceptionAction::Investigate, nullptr, Snapshot.ActorLocation);
+					if (Batch.bHasBlackboard)
+					{
+						State = EAIState::Investigating;
+					}
+				}
+				else
+				{
+					// 이미 활성 상태면 공격으로 전환
+					SensedSight(Snapshot.Actor);
+				}
+			}
+			else
+			{
+				// 먼 거리 - 계속 추적 (이미 공격 중이면 유지)
+				if (State == EAIState::Attacking)
+				{
+					SensedSight(Snapshot.Actor);
+				}
+			}
+			AddAction(EAIPerceptionAction::SetLastKnownLocation, nullptr, Snapshot.Sight.StimulusLocation);
+		}
+		else if (Snapshot.Sight.IsValid())
+		{
+			// 시야를 잃었을 때만 처리
+			AddAction(EAIPerceptionAction::LostSight, Snapshot.Actor, FVector::ZeroVector);
+			AddAction(EAIPerceptionAction::SetLastKnownLocation, nullptr, Snapshot.Sight.StimulusLocation);
+		}
+
+		// 청각 감지 체크
+		if (Snapshot.Hearing.IsValid() && Snapshot.Hearing.WasSuccessfullySensed())
 		{
-			bIsCorrectSense = true;
+			if (Snapshot.Hearing.Strength > 0.7f || Distance < 400.f)
+			{
+				// 큰 소리 또는 가까운 소리 - 정확한 위치로 조사
+				SensedSight(Snapshot.Actor);
+			}
+			else if (Snapshot.Hearing.Strength > 0.4f || Distance < 1000.f)
+			{
+				// 작은 소리 또는 먼 소리 - 자극 위치로 조사
+				AddAction(EAIPerceptionAction::SensedHearing, nullptr, Snapshot.Hearing.StimulusLocation);
+				if (Batch.bHasBlackboard && State != EAIState::Passive)
+				{
+					State = EAIState::Investigating;
+				}
+			}
 		}
+	}
+}
 
-		if (bIsCorrectSense && Stimulus.WasSuccessfullySensed())
+void ATPSTemplate_AIController::ApplyPerceptionBatch(const FAIPerceptionBatch& Batch)
+{
+	for (const FAIPerceptionAction& Action : Batch.Actions)
+	{
+		switch (Action.Type)
 		{
-			StimulusRef = Stimulus;
-			return true;
+		case EAIPerceptionAction::SensedSight:
+			// Perceived actors may have been destroyed between the snapshot and now
+			if (AActor* Actor = Action.Actor.Get())
+			{
+				HandleSensedSight(Actor);
+			}
+			break;
+		case EAIPerceptionAction::LostSight:
+			if (AActor* Actor = Action.Actor.Get())
+			{
+				HandleLostSight(Actor);
+			}
+			break;
+		case EAIPerceptionAction::SensedHearing:
+			HandleSensedHearing(Action.Location);
+			break;
+		case EAIPerceptionAction::Investigate:
+			SetStateAsInvestigating(Action.Location);
+			break;
+		case EAIPerceptionAction::SetLastKnownLocation:
+			LastKnownLocation = Action.Location;
+			break;
 		}
 	}
-	return false;
 }
 
 void ATPSTemplate_AIController::HandleSensedSight(AActor* Actor)
@@ -219,91 +396,15 @@ void ATPSTemplate_AIController::OnPerceptionUpdated(const TArray<AActor*>& Updat
 	// GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Cyan,
 	// 	FString::Printf(TEXT("OnPerceptionUpdated called with %d actors"), UpdateActors.Num()));
 
-	for (AActor* Actor : UpdateActors)
+	// The director decides for every controller in one parallel batch and applies the results on the game thread
+	if (UAIDirectorSubsystem* Director = GetWorld()->GetSubsystem<UAIDirectorSubsystem>())
 	{
-		APlayer_Base* Player = Cast<APlayer_Base>(Actor);
-		if (!Player)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Orange,
-				FString::Printf(TEXT("Actor %s is not Player_Base, skipping"), Actor ? *Actor->GetName() : TEXT("NULL")));
-			continue;
-		}
-
-		float Distance = FVector::Dist(GetPawn()->GetActorLocation(), Player->GetActorLocation());
-
-		FAIStimulus SightStimulus;
-		FAIStimulus HearingStimulus;
-		FAIStimulus DamageStimulus;
-		//GEngine->AddOnScreenDebugMessage(-1, 1.f, FColor::Yellow, FString::Printf(TEXT("Distance: %lf"), Distance));
-		// 시각 감지 체크
-		if (CanSenseActor(Player, ESenseType::Sight, SightStimulus))
-		{
-			// 성공적으로 시야에 들어옴 - 거리에 따른 반응
-			if (Distance < 300.f)
-			{
-				// 가까운 거리 - 즉시 공격
-				HandleSensedSight(Player);
-			}
-			else if (Distance < 800.f)
-			{
-				// 중간 거리 - 조사 또는 추적
-				if (AIState == EAIState::Passive)
-				{
-					SetStateAsInvestigating(Player->GetActorLocation());
-				}
-				else
-				{
-					// 이미 활성 상태면 공격으로 전환
-					HandleSensedSight(Player);
-				}
-			}
-			else
-			{
-				// 먼 거리 - 계속 추적 (이미 공격 중이면 유지)
-				if (AIState == EAIState::Attacking)
-				{
-					HandleSensedSight(Player);
-				}
-			}
-			LastKnownLocation = SightStimulus.StimulusLocation;
-		}
-		else
-		{
-			// 시야를 잃음
-			FActorPerceptionBlueprintInfo Info;
-			AIPerception->GetActorsPerception(Player, Info);
-
-			// 이전에 감지했던 적이 있는지 확인
-			for (const FAIStimulus& Stimulus : Info.LastSensedStimuli)
-			{
-				TSubclassOf<UAISense> SenseClass = UAIPerceptionSystem::GetSenseClassForStimulus(this, Stimulus);
-				if (SenseClass == UAISense_Sight::StaticClass())
-				{
-					if (!Stimulus.WasSuccessfullySensed())
-					{
-						// 시야를 잃었을 때만 처리
-						HandleLostSight(Player);
-						LastKnownLocation = Stimulus.StimulusLocation;
-					}
-					break;
-				}
-			}
-		}
-
-		// 청각 감지 체크
-		if (CanSenseActor(Player, ESenseType::Hearing, HearingStimulus))
-		{
-			if (HearingStimulus.Strength > 0.7f || Distance < 400.f)
-			{
-				// 큰 소리 또는 가까운 소리 - 정확한 위치로 조사
-				HandleSensedSight(Player);
-			}
-			else if (HearingStimulus.Strength > 0.4f || Distance < 1000.f)
-			{
-				// 작은 소리 또는 먼 소리 - 자극 위치로 조사
-				HandleSensedHearing(HearingStimulus.StimulusLocation);
-			}
-		}
-
+		Director->QueuePerception(this, UpdateActors);
+		return;
 	}
+
+	FAIPerceptionBatch Batch;
+	BuildPerceptionBatch(UpdateActors, Batch);
+	DecidePerception(Batch);
+	ApplyPerceptionBatch(Batch);
 }
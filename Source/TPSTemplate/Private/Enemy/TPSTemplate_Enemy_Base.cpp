@@ -5,6 +5,7 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Enemy/TPSTemplate_AIController.h"
+#include "Subsystems/EnemySignificanceSubsystem.h"
 
 ATPSTemplate_Enemy_Base::ATPSTemplate_Enemy_Base()
 	:Super()
@@ -17,11 +18,21 @@ ATPSTemplate_Enemy_Base::ATPSTemplate_Enemy_Base()
 	
 	// 자동으로 AI 컨트롤러 Possess 설정
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+
+	// Far and off-screen enemies evaluate animation less often (rates set by UEnemySignificanceSubsystem)
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 }
 
 void ATPSTemplate_Enemy_Base::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Update rates follow distance/visibility to the player from here on
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		Significance->RegisterEnemy(this);
+	}
+
 	if (Primary)
 	{
 		Primary->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, FName("RifleHost_Socket"));
@@ -49,3 +60,13 @@ void ATPSTemplate_Enemy_Base::BeginPlay()
 		}
 	}
 }
+
+void ATPSTemplate_Enemy_Base::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		Significance->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/AIDirectorSubsystem.h"
+#include "TPSTemplate.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Director Decide"), STAT_AIDirectorDecide, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("AI Director Apply"), STAT_AIDirectorApply, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Director Controllers"), STAT_AIDirectorControllers, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Director Snapshots"), STAT_AIDirectorSnapshots, STATGROUP_TPSTemplate);
+
+void UAIDirectorSubsystem::QueuePerception(ATPSTemplate_AIController* Controller, const TArray<AActor*>& UpdateActors)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	FAIPerceptionBatch Batch;
+	Controller->BuildPerceptionBatch(UpdateActors, Batch);
+	INC_DWORD_STAT_BY(STAT_AIDirectorSnapshots, Batch.Snapshots.Num());
+
+	// A second update in the same frame continues from the state the first one started with
+	int32& QueuedIndex = QueuedIndexByController.FindOrAdd(Controller, INDEX_NONE);
+	if (QueuedIndex != INDEX_NONE)
+	{
+		Queued[QueuedIndex].Batch.Snapshots.Append(Batch.Snapshots);
+		return;
+	}
+
+	QueuedIndex = Queued.Num();
+	FQueuedPerception& Entry = Queued.AddDefaulted_GetRef();
+	Entry.Controller = Controller;
+	Entry.Batch = MoveTemp(Batch);
+}
+
+void UAIDirectorSubsystem::Deinitialize()
+{
+	Queued.Empty();
+	QueuedIndexByController.Empty();
+
+	Super::Deinitialize();
+}
+
+void UAIDirectorSubsystem::Tick(float DeltaTime)
+{
+	if (Queued.Num() == 0)
+	{
+		return;
+	}
+
+	// Applying can trigger new perception events; they go into the next frame's batch
+	TArray<FQueuedPerception> Batches = MoveTemp(Queued);
+	Queued.Reset();
+	QueuedIndexByController.Reset();
+
+	INC_DWORD_STAT_BY(STAT_AIDirectorControllers, Batches.Num());
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AIDirectorDecide);
+
+		ParallelFor(Batches.Num(), [&Batches](int32 Index)
+		{
+			ATPSTemplate_AIController::DecidePerception(Batches[Index].Batch);
+		}, Batches.Num() < MinParallelBatches ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AIDirectorApply);
+
+		for (const FQueuedPerception& Entry : Batches)
+		{
+			if (ATPSTemplate_AIController* Controller = Entry.Controller.Get())
+			{
+				Controller->ApplyPerceptionBatch(Entry.Batch);
+			}
+		}
+	}
+}
+
+TStatId UAIDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAIDirectorSubsystem, STATGROUP_Tickables);
+}
+
+bool UAIDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
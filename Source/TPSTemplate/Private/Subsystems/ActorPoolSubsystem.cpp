@@ -0,0 +1,254 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "TPSTemplate.h"
+#include "Interfaces/PooledActor.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("ActorPool Acquire"), STAT_ActorPoolAcquire, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("ActorPool Tick"), STAT_ActorPoolTick, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ActorPool Spawns"), STAT_ActorPoolSpawns, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ActorPool Spawns Avoided"), STAT_ActorPoolSpawnsAvoided, STATGROUP_TPSTemplate);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("ActorPool Spawn Time Saved (ms)"), STAT_ActorPoolTimeSaved, STATGROUP_TPSTemplate);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ActorPool Active"), STAT_ActorPoolActive, STATGROUP_TPSTemplate);
+
+void UActorPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (!ActorClass)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>& Free = FreeActors.FindOrAdd(ActorClass.Get());
+	Free.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); });
+
+	const int32 Target = FMath::Min(Count, MaxFreePerClass);
+	while (Free.Num() < Target)
+	{
+		AActor* Actor = SpawnPooledActor(ActorClass);
+		if (!Actor)
+		{
+			break;
+		}
+		DeactivateActor(Actor);
+		Free.Add(Actor);
+	}
+}
+
+AActor* UActorPoolSubsystem::Acquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, float Lifetime, AActor* Owner, APawn* Instigator)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolAcquire);
+
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	AActor* Actor = nullptr;
+	if (TArray<TWeakObjectPtr<AActor>>* Free = FreeActors.Find(ActorClass.Get()))
+	{
+		while (!Actor && Free->Num() > 0)
+		{
+			Actor = Free->Pop(EAllowShrinking::No).Get();
+		}
+	}
+
+	if (Actor)
+	{
+		++NumReuses;
+		INC_DWORD_STAT(STAT_ActorPoolSpawnsAvoided);
+		INC_FLOAT_STAT_BY(STAT_ActorPoolTimeSaved, static_cast<float>(AverageSpawnMs));
+	}
+	else
+	{
+		Actor = SpawnPooledActor(ActorClass);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+	}
+
+	ActivateActor(Actor, Transform, Owner, Instigator);
+
+	const uint32 Serial = ++NextSerial;
+	ActiveSerials.Add(Actor, Serial);
+	INC_DWORD_STAT(STAT_ActorPoolActive);
+
+	if (Lifetime <= 0.0f)
+	{
+		Lifetime = ActorClass->GetDefaultObject<AActor>()->InitialLifeSpan;
+	}
+	if (Lifetime > 0.0f)
+	{
+		TimedActors.HeapPush({ Actor, GetWorld()->GetTimeSeconds() + Lifetime, Serial });
+	}
+
+	return Actor;
+}
+
+void UActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!Actor || ActiveSerials.Remove(Actor) == 0)
+	{
+		// Not acquired from this pool (or already released)
+		return;
+	}
+	DEC_DWORD_STAT(STAT_ActorPoolActive);
+
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>& Free = FreeActors.FindOrAdd(Actor->GetClass());
+	if (Free.Num() >= MaxFreePerClass)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	DeactivateActor(Actor);
+	Free.Add(Actor);
+}
+
+int32 UActorPoolSubsystem::GetNumFree(TSubclassOf<AActor> ActorClass) const
+{
+	const TArray<TWeakObjectPtr<AActor>>* Free = FreeActors.Find(ActorClass.Get());
+	return Free ? Free->Num() : 0;
+}
+
+void UActorPoolSubsystem::Deinitialize()
+{
+	UE_LOG(LogTemp, Log, TEXT("[ActorPoolSubsystem] %d spawns, %d reuses (~%.2f ms of SpawnActor avoided)"),
+		NumSpawns, NumReuses, NumReuses * AverageSpawnMs);
+
+	DEC_DWORD_STAT_BY(STAT_ActorPoolActive, ActiveSerials.Num());
+
+	FreeActors.Empty();
+	TimedActors.Empty();
+	ActiveSerials.Empty();
+
+	Super::Deinitialize();
+}
+
+void UActorPoolSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolTick);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (TimedActors.Num() > 0 && TimedActors.HeapTop().ReleaseTime <= Now)
+	{
+		FActiveEntry Entry;
+		TimedActors.HeapPop(Entry, EAllowShrinking::No);
+
+		AActor* Actor = Entry.Actor.Get();
+		const uint32* Serial = Actor ? ActiveSerials.Find(Actor) : nullptr;
+		if (Serial && *Serial == Entry.Serial)
+		{
+			Release(Actor);
+		}
+	}
+
+	// Acquired actors destroyed by someone else never come back through Release
+	if (Now >= NextStaleSweepTime)
+	{
+		NextStaleSweepTime = Now + StaleSweepInterval;
+		for (auto It = ActiveSerials.CreateIterator(); It; ++It)
+		{
+			if (!IsValid(It->Key.ResolveObjectPtr()))
+			{
+				It.RemoveCurrent();
+				DEC_DWORD_STAT(STAT_ActorPoolActive);
+			}
+		}
+	}
+}
+
+TStatId UActorPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UActorPoolSubsystem, STATGROUP_Tickables);
+}
+
+bool UActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AActor* UActorPoolSubsystem::SpawnPooledActor(UClass* ActorClass)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	AActor* Actor = GetWorld()->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams);
+	const double SpawnMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	if (!Actor)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ActorPoolSubsystem] Failed to spawn %s"), *GetNameSafe(ActorClass));
+		return nullptr;
+	}
+
+	++NumSpawns;
+	AverageSpawnMs += (SpawnMs - AverageSpawnMs) / NumSpawns;
+	INC_DWORD_STAT(STAT_ActorPoolSpawns);
+
+	// The pool decides when the actor goes away, not InitialLifeSpan
+	Actor->SetLifeSpan(0.0f);
+	return Actor;
+}
+
+void UActorPoolSubsystem::ActivateActor(AActor* Actor, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	Actor->SetOwner(Owner);
+	Actor->SetInstigator(Instigator);
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(true);
+	Actor->SetActorTickEnabled(true);
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (!Component || !Component->bAutoActivate)
+		{
+			continue;
+		}
+
+		// Movement restarts along the new facing, like a freshly spawned projectile
+		UProjectileMovementComponent* Movement = Cast<UProjectileMovementComponent>(Component);
+		if (Movement && Movement->InitialSpeed > 0.0f)
+		{
+			Movement->SetUpdatedComponent(Actor->GetRootComponent());
+			Movement->Velocity = Actor->GetActorForwardVector() * Movement->InitialSpeed;
+			Movement->UpdateComponentVelocity();
+		}
+		Component->Activate(true);
+	}
+
+	if (Actor->Implements<UPooledActor>())
+	{
+		IPooledActor::Execute_OnAcquiredFromPool(Actor);
+	}
+}
+
+void UActorPoolSubsystem::DeactivateActor(AActor* Actor)
+{
+	if (Actor->Implements<UPooledActor>())
+	{
+		IPooledActor::Execute_OnReleasedToPool(Actor);
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && Component->bAutoActivate)
+		{
+			Component->Deactivate();
+		}
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetOwner(nullptr);
+}
@@ -0,0 +1,327 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/BallisticsSubsystem.h"
+#include "TPSTemplate.h"
+#include "Weapon/MasterWeapon.h"
+#include "Components/WeaponSystem.h"
+#include "Data/WeaponData.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ballistics Tick"), STAT_BallisticsTick, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("Ballistics Integrate"), STAT_BallisticsIntegrate, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("Ballistics Queue Segments"), STAT_BallisticsQueueSegments, STATGROUP_TPSTemplate);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ballistics Projectiles"), STAT_BallisticsProjectiles, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ballistics Impacts"), STAT_BallisticsImpacts, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ballistics Segment Retraces"), STAT_BallisticsSegmentRetraces, STATGROUP_TPSTemplate);
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs BallisticsBenchmarkCommand(
+		TEXT("tps.Weapon.BallisticsBenchmark"),
+		TEXT("tps.Weapon.BallisticsBenchmark [Count=10000] [Steps=120]: time the projectile integration step, parallel and serial."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBallisticsSubsystem* Ballistics = World ? World->GetSubsystem<UBallisticsSubsystem>() : nullptr;
+			if (!Ballistics)
+			{
+				UE_LOG(LogTPSWeapon, Warning, TEXT("[Ballistics] tps.Weapon.BallisticsBenchmark needs a game world"));
+				return;
+			}
+
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+			const int32 Steps = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 120;
+			Ballistics->RunBenchmark(Count, Steps);
+		}),
+		ECVF_Cheat
+	);
+}
+
+void UBallisticsSubsystem::FireProjectile(AMasterWeapon* Weapon, const FVector& Origin, const FVector& Direction)
+{
+	if (!Weapon || !Weapon->WeaponData)
+	{
+		return;
+	}
+
+	const UWeaponData* Data = Weapon->WeaponData;
+	const FVector Velocity = Direction.GetSafeNormal() * Data->MuzzleVelocity;
+	AddProjectile(Weapon, Origin, Velocity, Data->DragCoefficient, GetWorld()->GetGravityZ() * Data->GravityScale, Data->MaxRange);
+}
+
+void UBallisticsSubsystem::AddProjectile(AMasterWeapon* Weapon, const FVector& Origin, const FVector& Velocity, float DragCoefficient, float Gravity, float Range)
+{
+	PosX.Add(Origin.X);
+	PosY.Add(Origin.Y);
+	PosZ.Add(Origin.Z);
+	VelX.Add(Velocity.X);
+	VelY.Add(Velocity.Y);
+	VelZ.Add(Velocity.Z);
+	PrevX.Add(Origin.X);
+	PrevY.Add(Origin.Y);
+	PrevZ.Add(Origin.Z);
+	Drag.Add(DragCoefficient);
+	GravityZ.Add(Gravity);
+	RemainingRange.Add(Range);
+
+	Weapons.Add(Weapon);
+	Origins.Add(Origin);
+	bAlive.Add(1);
+}
+
+void UBallisticsSubsystem::RunBenchmark(int32 Count, int32 NumSteps)
+{
+	if (PosX.Num() > 0)
+	{
+		UE_LOG(LogTPSWeapon, Warning, TEXT("[Ballistics] Benchmark needs no projectiles in flight (%d now)"), PosX.Num());
+		return;
+	}
+
+	Count = FMath::Max(Count, 1);
+	NumSteps = FMath::Max(NumSteps, 1);
+	constexpr float StepTime = 1.0f / 60.0f;
+
+	// Rifle-like rounds fanned out upwards, so none of them runs out of range during the run
+	FRandomStream Random(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FVector Direction = FVector(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), 1.0f).GetSafeNormal();
+		AddProjectile(nullptr, FVector::ZeroVector, Direction * 90000.0f, 0.0001f, GetWorld()->GetGravityZ(), TNumericLimits<float>::Max());
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		Integrate(StepTime);
+	}
+	const double ParallelTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		Integrate(StepTime, false);
+	}
+	const double SerialTime = FPlatformTime::Seconds() - StartTime;
+
+	// Synthetic projectiles have no weapon and must not reach QueueSegments
+	for (int32 i = PosX.Num() - 1; i >= 0; --i)
+	{
+		RemoveAtSwap(i);
+	}
+
+	UE_LOG(LogTPSWeapon, Display, TEXT("[Ballistics] Benchmark %d projectiles, %d steps: parallel %.3f ms/step, serial %.3f ms/step (%.1fx)"),
+		Count, NumSteps, ParallelTime * 1000.0 / NumSteps, SerialTime * 1000.0 / NumSteps,
+		ParallelTime > 0.0 ? SerialTime / ParallelTime : 0.0);
+}
+
+void UBallisticsSubsystem::Deinitialize()
+{
+	PendingSegments.Empty();
+	PendingImpacts.Empty();
+	for (TArray<float>* Array : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ, &PrevX, &PrevY, &PrevZ, &Drag, &GravityZ, &RemainingRange })
+	{
+		Array->Empty();
+	}
+	Weapons.Empty();
+	Origins.Empty();
+	bAlive.Empty();
+
+	Super::Deinitialize();
+}
+
+void UBallisticsSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BallisticsTick);
+
+	ResolveSegments();
+	Compact();
+	Integrate(DeltaTime);
+	QueueSegments();
+
+	SET_DWORD_STAT(STAT_BallisticsProjectiles, PosX.Num());
+	INC_DWORD_STAT_BY(STAT_BallisticsImpacts, PendingImpacts.Num());
+
+	// Hit handling may fire again, so it runs after this frame's bookkeeping is done
+	TArray<FImpact> Impacts = MoveTemp(PendingImpacts);
+	for (const FImpact& Impact : Impacts)
+	{
+		if (AMasterWeapon* Weapon = Impact.Weapon.Get())
+		{
+			Weapon->OnProjectileImpact(Impact.Hit, Impact.Origin);
+		}
+	}
+}
+
+TStatId UBallisticsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBallisticsSubsystem, STATGROUP_Tickables);
+}
+
+bool UBallisticsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBallisticsSubsystem::ResolveSegments()
+{
+	UWorld* World = GetWorld();
+
+	FTraceDatum Datum;
+	FHitResult RetraceHit;
+	for (const FPendingSegment& Segment : PendingSegments)
+	{
+		// Indices are stable here: nothing has been removed or integrated since the segments were queued
+		const int32 Index = Segment.ProjectileIndex;
+
+		const FHitResult* Impact = nullptr;
+		if (World->QueryTraceData(Segment.Handle, Datum))
+		{
+			Impact = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		}
+		else if (AMasterWeapon* Weapon = Weapons[Index].Get())
+		{
+			// The async result is gone (e.g. the trace buffers turned over during a hitch): trace the segment now,
+			// otherwise the projectile would pass through whatever it crossed this step
+			INC_DWORD_STAT(STAT_BallisticsSegmentRetraces);
+			if (World->LineTraceSingleByChannel(RetraceHit, FVector(PrevX[Index], PrevY[Index], PrevZ[Index]),
+				FVector(PosX[Index], PosY[Index], PosZ[Index]), COLLISION_BULLET, MakeSegmentParams(Weapon)))
+			{
+				Impact = &RetraceHit;
+			}
+		}
+
+		if (Impact)
+		{
+			bAlive[Index] = 0;
+			PendingImpacts.Add({ Weapons[Index], *Impact, Origins[Index] });
+		}
+	}
+	PendingSegments.Reset();
+}
+
+void UBallisticsSubsystem::Compact()
+{
+	for (int32 i = PosX.Num() - 1; i >= 0; --i)
+	{
+		if (!bAlive[i] || RemainingRange[i] <= 0.0f || !Weapons[i].IsValid())
+		{
+			RemoveAtSwap(i);
+		}
+	}
+}
+
+void UBallisticsSubsystem::Integrate(float DeltaTime, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BallisticsIntegrate);
+
+	const int32 Num = PosX.Num();
+	if (Num == 0)
+	{
+		return;
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, IntegrationChunkSize);
+	ParallelFor(NumChunks, [this, Num, DeltaTime](int32 Chunk)
+	{
+		const int32 Begin = Chunk * IntegrationChunkSize;
+		const int32 End = FMath::Min(Begin + IntegrationChunkSize, Num);
+
+		float* RESTRICT PX = PosX.GetData();
+		float* RESTRICT PY = PosY.GetData();
+		float* RESTRICT PZ = PosZ.GetData();
+		float* RESTRICT VX = VelX.GetData();
+		float* RESTRICT VY = VelY.GetData();
+		float* RESTRICT VZ = VelZ.GetData();
+		float* RESTRICT LX = PrevX.GetData();
+		float* RESTRICT LY = PrevY.GetData();
+		float* RESTRICT LZ = PrevZ.GetData();
+		float* RESTRICT Range = RemainingRange.GetData();
+		const float* RESTRICT K = Drag.GetData();
+		const float* RESTRICT G = GravityZ.GetData();
+
+		// Branch-free semi-implicit Euler so the compiler can vectorize the loop
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const float Speed = FMath::Sqrt(VX[i] * VX[i] + VY[i] * VY[i] + VZ[i] * VZ[i]);
+			const float DragScale = 1.0f - FMath::Min(K[i] * Speed * DeltaTime, 1.0f);
+
+			VX[i] *= DragScale;
+			VY[i] *= DragScale;
+			VZ[i] = VZ[i] * DragScale + G[i] * DeltaTime;
+
+			LX[i] = PX[i];
+			LY[i] = PY[i];
+			LZ[i] = PZ[i];
+
+			PX[i] += VX[i] * DeltaTime;
+			PY[i] += VY[i] * DeltaTime;
+			PZ[i] += VZ[i] * DeltaTime;
+
+			Range[i] -= Speed * DeltaTime;
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void UBallisticsSubsystem::QueueSegments()
+{
+	SCOPE_CYCLE_COUNTER(STAT_BallisticsQueueSegments);
+
+	UWorld* World = GetWorld();
+
+	// One set of ignore params per firing weapon (the weapon and its owner)
+	TMap<AMasterWeapon*, FCollisionQueryParams> ParamsByWeapon;
+
+	const int32 Num = PosX.Num();
+	PendingSegments.Reserve(Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		AMasterWeapon* Weapon = Weapons[i].Get();
+
+		FCollisionQueryParams* Params = ParamsByWeapon.Find(Weapon);
+		if (!Params)
+		{
+			Params = &ParamsByWeapon.Add(Weapon, MakeSegmentParams(Weapon));
+		}
+
+		FPendingSegment& Segment = PendingSegments.AddDefaulted_GetRef();
+		Segment.ProjectileIndex = i;
+		Segment.Handle = World->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			FVector(PrevX[i], PrevY[i], PrevZ[i]),
+			FVector(PosX[i], PosY[i], PosZ[i]),
+			COLLISION_BULLET,
+			*Params
+		);
+	}
+}
+
+FCollisionQueryParams UBallisticsSubsystem::MakeSegmentParams(AMasterWeapon* Weapon)
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(BallisticsSegment));
+	Params.AddIgnoredActor(Weapon);
+	if (Weapon->WeaponSystem && Weapon->WeaponSystem->CharacterRef)
+	{
+		Params.AddIgnoredActor(Weapon->WeaponSystem->CharacterRef);
+	}
+	return Params;
+}
+
+void UBallisticsSubsystem::RemoveAtSwap(int32 Index)
+{
+	PosX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PosY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PosZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PrevX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PrevY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PrevZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Drag.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingRange.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Weapons.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Origins.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	bAlive.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/DamageAggregatorSubsystem.h"
+#include "TPSTemplate.h"
+#include "Weapon/MasterWeapon.h"
+#include "Interfaces/Damageable.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Aggregator Flush"), STAT_DamageAggregatorFlush, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Hits Queued"), STAT_DamageHitsQueued, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Hits Merged"), STAT_DamageHitsMerged, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events Applied"), STAT_DamageEventsApplied, STATGROUP_TPSTemplate);
+
+void UDamageAggregatorSubsystem::QueueHit(AMasterWeapon* Weapon, const FHitResult& HitResult, float Damage)
+{
+	AActor* HitActor = HitResult.GetActor();
+	if (!Weapon || !HitActor)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_DamageHitsQueued);
+
+	FPendingHit* Existing = PendingHits.FindByPredicate([Weapon, HitActor, &HitResult](const FPendingHit& Pending)
+	{
+		return Pending.Weapon.Get() == Weapon
+			&& Pending.Hit.GetActor() == HitActor
+			&& Pending.Hit.BoneName == HitResult.BoneName;
+	});
+
+	if (Existing)
+	{
+		Existing->Damage += Damage;
+		INC_DWORD_STAT(STAT_DamageHitsMerged);
+		return;
+	}
+
+	FPendingHit& Pending = PendingHits.AddDefaulted_GetRef();
+	Pending.Weapon = Weapon;
+	Pending.Hit = HitResult;
+	Pending.Damage = Damage;
+}
+
+void UDamageAggregatorSubsystem::Flush()
+{
+	SCOPE_CYCLE_COUNTER(STAT_DamageAggregatorFlush);
+
+	if (PendingHits.Num() == 0)
+	{
+		return;
+	}
+
+	// Damage reactions may shoot back (and queue) - work on a detached batch
+	TArray<FPendingHit> Hits = MoveTemp(PendingHits);
+	PendingHits.Reset();
+
+	struct FWeaponFeedback
+	{
+		AMasterWeapon* Weapon = nullptr;
+		bool bValidHit = false;
+		bool bKilled = false;
+	};
+	TArray<FWeaponFeedback, TInlineAllocator<4>> Feedback;
+
+	auto FindFeedback = [&Feedback](AMasterWeapon* Weapon) -> FWeaponFeedback&
+	{
+		if (FWeaponFeedback* Found = Feedback.FindByPredicate([Weapon](const FWeaponFeedback& Entry) { return Entry.Weapon == Weapon; }))
+		{
+			return *Found;
+		}
+		FWeaponFeedback& Added = Feedback.AddDefaulted_GetRef();
+		Added.Weapon = Weapon;
+		return Added;
+	};
+
+	for (const FPendingHit& Pending : Hits)
+	{
+		AMasterWeapon* Weapon = Pending.Weapon.Get();
+		if (!Weapon)
+		{
+			continue;
+		}
+
+		const float ActualDamage = Weapon->ApplyDamage(Pending.Hit, Pending.Damage);
+		INC_DWORD_STAT(STAT_DamageEventsApplied);
+
+		if (ActualDamage > 0.0f)
+		{
+			FindFeedback(Weapon).bValidHit = true;
+		}
+	}
+
+	// One death check per victim, after all of its bones took their damage
+	TArray<TPair<AActor*, bool>, TInlineAllocator<8>> VictimStates;
+	for (const FPendingHit& Pending : Hits)
+	{
+		AMasterWeapon* Weapon = Pending.Weapon.Get();
+		AActor* Victim = Pending.Hit.GetActor();
+		if (!Weapon || !IsValid(Victim) || !Victim->Implements<UDamageable>())
+		{
+			continue;
+		}
+
+		const TPair<AActor*, bool>* State = VictimStates.FindByPredicate([Victim](const TPair<AActor*, bool>& Entry) { return Entry.Key == Victim; });
+		if (!State)
+		{
+			State = &VictimStates.Emplace_GetRef(Victim, IDamageable::Execute_IsDead(Victim));
+		}
+
+		if (State->Value)
+		{
+			FindFeedback(Weapon).bKilled = true;
+		}
+	}
+
+	for (const FWeaponFeedback& Entry : Feedback)
+	{
+		Entry.Weapon->PlayHitFeedback(Entry.bValidHit, Entry.bKilled);
+	}
+}
+
+void UDamageAggregatorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Post actor tick runs after tickable objects, so the hitscan / ballistics resolves of this frame are already queued
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDamageAggregatorSubsystem::OnWorldPostActorTick);
+}
+
+void UDamageAggregatorSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingHits.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UDamageAggregatorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamageAggregatorSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		Flush();
+	}
+}
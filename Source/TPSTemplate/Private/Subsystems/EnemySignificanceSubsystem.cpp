@@ -0,0 +1,446 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemySignificanceSubsystem.h"
+#include "TPSTemplate.h"
+#include "Enemy/TPSTemplate_Enemy_Base.h"
+#include "Enemy/Infector_Base.h"
+#include "Enemy/TPSTemplate_AIController.h"
+#include "AIController.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance Update"), STAT_EnemySignificanceUpdate, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Significance Evaluations"), STAT_EnemySignificanceEvaluations, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Significance Changes"), STAT_EnemySignificanceChanges, STATGROUP_TPSTemplate);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Critical"), STAT_EnemiesCritical, STATGROUP_TPSTemplate);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Dormant"), STAT_EnemiesDormant, STATGROUP_TPSTemplate);
+
+namespace
+{
+	/** Update rates of one significance bucket (tick intervals in seconds, 0 = every frame) */
+	struct FSignificanceBucket
+	{
+		float MaxDistance;
+		float ActorTickInterval;
+		float MovementTickInterval;
+		/** Animation frames skipped between updates (URO, interpolated); 0 leaves the engine's LOD-based rate */
+		int32 AnimationFrameSkip;
+		/** Sight is the perception sense that costs per listener (line traces); off, the enemy still hears and takes damage */
+		bool bSightEnabled;
+	};
+
+	// Indexed by EEnemySignificance
+	constexpr FSignificanceBucket SignificanceBuckets[] =
+	{
+		/* Critical */ { 1500.0f, 0.0f, 0.0f, 0, true },
+		/* High */     { 4000.0f, 0.05f, 0.0f, 1, true },
+		/* Medium */   { 8000.0f, 0.1f, 0.066f, 2, true },
+		/* Dormant */  { TNumericLimits<float>::Max(), 0.5f, 0.25f, 4, false },
+	};
+
+	/** Skipped animation frames are interpolated up to this evaluation rate */
+	constexpr int32 MaxAnimationEvalRateForInterpolation = 8;
+	constexpr int32 NumSignificanceBuckets = UE_ARRAY_COUNT(SignificanceBuckets);
+
+	int32 SignificanceUpdatesPerFrame = 64;
+
+	FAutoConsoleVariableRef CVarSignificanceUpdatesPerFrame(
+		TEXT("tps.AI.SignificanceUpdatesPerFrame"),
+		SignificanceUpdatesPerFrame,
+		TEXT("Enemies whose significance bucket is re-evaluated per frame (round-robin)."),
+		ECVF_Scalability
+	);
+
+	bool bSignificanceEnabled = true;
+
+	FAutoConsoleVariableRef CVarSignificanceEnabled(
+		TEXT("tps.AI.SignificanceEnabled"),
+		bSignificanceEnabled,
+		TEXT("0 keeps every enemy at full update rate (no significance throttling); for profiling against a baseline."),
+		ECVF_Default
+	);
+
+	/** Frames skipped after spawning before the benchmark starts measuring */
+	constexpr int32 BenchmarkWarmupFrames = 30;
+
+	FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("tps.AI.Benchmark"),
+		TEXT("tps.AI.Benchmark [Count=500] [Frames=300] [EnemyClass=AInfector_Base]: spawn Count enemies around the player and log the average frame time ")
+		TEXT("without and with significance throttling, then destroy them. ")
+		TEXT("EnemyClass is a class path such as /Game/.../BP_Infector.BP_Infector_C; the native class has no mesh or animation."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UEnemySignificanceSubsystem* Significance = World ? World->GetSubsystem<UEnemySignificanceSubsystem>() : nullptr;
+			if (!Significance)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[EnemySignificance] tps.AI.Benchmark needs a game world"));
+				return;
+			}
+
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500;
+			const int32 Frames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 300;
+
+			TSubclassOf<ATPSTemplate_Enemy_Base> EnemyClass = AInfector_Base::StaticClass();
+			if (Args.Num() > 2)
+			{
+				EnemyClass = FSoftClassPath(Args[2]).TryLoadClass<ATPSTemplate_Enemy_Base>();
+				if (!EnemyClass)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("[EnemySignificance] tps.AI.Benchmark: %s is not an enemy class"), *Args[2]);
+					return;
+				}
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[EnemySignificance] tps.AI.Benchmark: no EnemyClass given, spawning native AInfector_Base (no mesh or animation)"));
+			}
+
+			Significance->RunBenchmark(Count, Frames, EnemyClass);
+		}),
+		ECVF_Cheat
+	);
+}
+
+void UEnemySignificanceSubsystem::RegisterEnemy(ATPSTemplate_Enemy_Base* Enemy)
+{
+	if (!Enemy || Enemies.ContainsByPredicate([Enemy](const FTrackedEnemy& Entry) { return Entry.Enemy.Get() == Enemy; }))
+	{
+		return;
+	}
+
+	// Start at full rate; the round-robin lowers it once the enemy is evaluated
+	FTrackedEnemy& Entry = Enemies.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+	Entry.Significance = EEnemySignificance::Critical;
+	INC_DWORD_STAT(STAT_EnemiesCritical);
+}
+
+void UEnemySignificanceSubsystem::UnregisterEnemy(ATPSTemplate_Enemy_Base* Enemy)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	const int32 Index = Enemies.IndexOfByPredicate([Enemy](const FTrackedEnemy& Entry) { return Entry.Enemy.Get() == Enemy; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	RemoveEnemyAt(Index);
+}
+
+void UEnemySignificanceSubsystem::RemoveEnemyAt(int32 Index)
+{
+	if (Enemies[Index].Significance == EEnemySignificance::Critical)
+	{
+		DEC_DWORD_STAT(STAT_EnemiesCritical);
+	}
+	else if (Enemies[Index].Significance == EEnemySignificance::Dormant)
+	{
+		DEC_DWORD_STAT(STAT_EnemiesDormant);
+	}
+	Enemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UEnemySignificanceSubsystem::RunBenchmark(int32 Count, int32 NumFrames, TSubclassOf<ATPSTemplate_Enemy_Base> EnemyClass)
+{
+	if (!EnemyClass)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const APlayerController* PC = World->GetFirstPlayerController();
+	const APawn* PlayerPawn = PC ? PC->GetPawn() : nullptr;
+	const FVector Center = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// Square grid around the player, spread far enough to cover every bucket
+	constexpr float Spacing = 300.0f;
+	const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))));
+	const FVector Origin = Center - FVector(Columns * Spacing * 0.5f, Columns * Spacing * 0.5f, 0.0f);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FVector Location = Origin + FVector((i % Columns) * Spacing, (i / Columns) * Spacing, 0.0f);
+		if (ATPSTemplate_Enemy_Base* Enemy = World->SpawnActor<ATPSTemplate_Enemy_Base>(EnemyClass, Location, FRotator::ZeroRotator, SpawnParams))
+		{
+			BenchmarkEnemies.Add(Enemy);
+		}
+	}
+
+	// Baseline phase first: everything at full rate
+	if (BenchmarkTargetFrames == 0)
+	{
+		bBenchmarkSavedEnabled = bSignificanceEnabled;
+	}
+	bSignificanceEnabled = false;
+	bBenchmarkThrottled = false;
+
+	BenchmarkTargetFrames = FMath::Max(1, NumFrames);
+	BenchmarkWarmupRemaining = BenchmarkWarmupFrames;
+	BenchmarkLastTickTime = FPlatformTime::Seconds();
+	BenchmarkFrames = 0;
+	BenchmarkFrameTime = 0.0;
+	BenchmarkSignificanceTime = 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("[EnemySignificance] Benchmark spawned %d/%d %s, measuring %d frames unthrottled, then %d throttled"),
+		BenchmarkEnemies.Num(), Count, *EnemyClass->GetName(), NumFrames, NumFrames);
+}
+
+EEnemySignificance UEnemySignificanceSubsystem::EvaluateSignificance(const ATPSTemplate_Enemy_Base* Enemy, const FVector& ViewLocation) const
+{
+	if (!bSignificanceEnabled)
+	{
+		return EEnemySignificance::Critical;
+	}
+
+	const float DistanceSquared = FVector::DistSquared(ViewLocation, Enemy->GetActorLocation());
+
+	int32 Bucket = NumSignificanceBuckets - 1;
+	for (int32 i = 0; i < NumSignificanceBuckets; ++i)
+	{
+		if (DistanceSquared <= FMath::Square(SignificanceBuckets[i].MaxDistance))
+		{
+			Bucket = i;
+			break;
+		}
+	}
+
+	// An attacking enemy keeps its sight: no off-screen drop, and never Dormant (an enemy behind the camera may be flanking)
+	const ATPSTemplate_AIController* Controller = Cast<ATPSTemplate_AIController>(Enemy->GetController());
+	if (Controller && Controller->IsAttacking())
+	{
+		return static_cast<EEnemySignificance>(FMath::Min(Bucket, static_cast<int32>(EEnemySignificance::Medium)));
+	}
+
+	// Off-screen enemies drop one bucket
+	if (!Enemy->WasRecentlyRendered(0.5f))
+	{
+		Bucket = FMath::Min(Bucket + 1, NumSignificanceBuckets - 1);
+	}
+
+	return static_cast<EEnemySignificance>(Bucket);
+}
+
+void UEnemySignificanceSubsystem::ApplySignificance(ATPSTemplate_Enemy_Base* Enemy, EEnemySignificance Significance)
+{
+	const FSignificanceBucket& Bucket = SignificanceBuckets[static_cast<int32>(Significance)];
+
+	Enemy->SetActorTickInterval(Bucket.ActorTickInterval);
+
+	if (UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+	{
+		Movement->SetComponentTickInterval(Bucket.MovementTickInterval);
+	}
+
+	// Animation keeps ticking every frame so URO can interpolate the poses it skips evaluating
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+	if (FAnimUpdateRateParameters* AnimUpdateRate = Mesh ? Mesh->AnimUpdateRateParams : nullptr)
+	{
+		AnimUpdateRate->bShouldUseLODMap = Bucket.AnimationFrameSkip > 0;
+		AnimUpdateRate->LODToFrameSkipMap.Reset();
+		for (int32 LODIndex = 0; LODIndex < Mesh->GetNumLODs(); ++LODIndex)
+		{
+			AnimUpdateRate->LODToFrameSkipMap.Add(LODIndex, Bucket.AnimationFrameSkip);
+		}
+		AnimUpdateRate->MaxEvalRateForInterpolation = MaxAnimationEvalRateForInterpolation;
+	}
+
+	// Perception is updated by the perception system, not by component ticks, so the bucket can only switch sight off
+	const AAIController* Controller = Cast<AAIController>(Enemy->GetController());
+	if (UAIPerceptionComponent* Perception = Controller ? Controller->GetPerceptionComponent() : nullptr)
+	{
+		Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), Bucket.bSightEnabled);
+	}
+}
+
+void UEnemySignificanceSubsystem::SetSignificance(FTrackedEnemy& Entry, ATPSTemplate_Enemy_Base* Enemy, EEnemySignificance NewSignificance)
+{
+	if (Entry.Significance == EEnemySignificance::Critical)
+	{
+		DEC_DWORD_STAT(STAT_EnemiesCritical);
+	}
+	else if (Entry.Significance == EEnemySignificance::Dormant)
+	{
+		DEC_DWORD_STAT(STAT_EnemiesDormant);
+	}
+	if (NewSignificance == EEnemySignificance::Critical)
+	{
+		INC_DWORD_STAT(STAT_EnemiesCritical);
+	}
+	else if (NewSignificance == EEnemySignificance::Dormant)
+	{
+		INC_DWORD_STAT(STAT_EnemiesDormant);
+	}
+
+	Entry.Significance = NewSignificance;
+	ApplySignificance(Enemy, NewSignificance);
+	INC_DWORD_STAT(STAT_EnemySignificanceChanges);
+}
+
+void UEnemySignificanceSubsystem::ReevaluateAll()
+{
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	const FVector ViewLocation = PC && PC->PlayerCameraManager ? PC->PlayerCameraManager->GetCameraLocation() : FVector::ZeroVector;
+
+	for (FTrackedEnemy& Entry : Enemies)
+	{
+		if (ATPSTemplate_Enemy_Base* Enemy = Entry.Enemy.Get())
+		{
+			const EEnemySignificance NewSignificance = EvaluateSignificance(Enemy, ViewLocation);
+			if (NewSignificance != Entry.Significance)
+			{
+				SetSignificance(Entry, Enemy, NewSignificance);
+			}
+		}
+	}
+}
+
+void UEnemySignificanceSubsystem::Deinitialize()
+{
+	// A benchmark cut short by the world going away must not leave throttling off
+	if (BenchmarkTargetFrames > 0)
+	{
+		bSignificanceEnabled = bBenchmarkSavedEnabled;
+		BenchmarkTargetFrames = 0;
+	}
+	BenchmarkEnemies.Empty();
+
+	Enemies.Empty();
+	SET_DWORD_STAT(STAT_EnemiesCritical, 0);
+	SET_DWORD_STAT(STAT_EnemiesDormant, 0);
+
+	Super::Deinitialize();
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (bThrottlingApplied != bSignificanceEnabled)
+	{
+		bThrottlingApplied = bSignificanceEnabled;
+		ReevaluateAll();
+	}
+
+	if (Enemies.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_EnemySignificanceUpdate);
+
+		const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+		if (PC && PC->PlayerCameraManager)
+		{
+			const FVector ViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+			const int32 NumUpdates = FMath::Min(FMath::Max(SignificanceUpdatesPerFrame, 1), Enemies.Num());
+
+			for (int32 Update = 0; Update < NumUpdates && Enemies.Num() > 0; ++Update)
+			{
+				if (Cursor >= Enemies.Num())
+				{
+					Cursor = 0;
+				}
+
+				FTrackedEnemy& Entry = Enemies[Cursor];
+				ATPSTemplate_Enemy_Base* Enemy = Entry.Enemy.Get();
+				if (!Enemy)
+				{
+					// Destroyed without EndPlay reaching us - drop it, the swapped-in entry is evaluated next
+					RemoveEnemyAt(Cursor);
+					continue;
+				}
+				++Cursor;
+
+				INC_DWORD_STAT(STAT_EnemySignificanceEvaluations);
+				const EEnemySignificance NewSignificance = EvaluateSignificance(Enemy, ViewLocation);
+				if (NewSignificance != Entry.Significance)
+				{
+					SetSignificance(Entry, Enemy, NewSignificance);
+				}
+			}
+		}
+	}
+
+	if (BenchmarkTargetFrames > 0)
+	{
+		TickBenchmark(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void UEnemySignificanceSubsystem::TickBenchmark(double SignificanceTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double FrameTime = Now - BenchmarkLastTickTime;
+	BenchmarkLastTickTime = Now;
+
+	// Warm-up frames absorb the spawn hitch and the first significance passes
+	if (BenchmarkWarmupRemaining > 0)
+	{
+		--BenchmarkWarmupRemaining;
+		return;
+	}
+
+	BenchmarkFrameTime += FrameTime;
+	BenchmarkSignificanceTime += SignificanceTime;
+	if (++BenchmarkFrames < BenchmarkTargetFrames)
+	{
+		return;
+	}
+
+	if (!bBenchmarkThrottled)
+	{
+		// Baseline done: switch throttling on (re-buckets everything next tick) and measure again after a warm-up
+		BenchmarkBaselineFrameTime = BenchmarkFrameTime / BenchmarkFrames;
+		BenchmarkBaselineSignificanceTime = BenchmarkSignificanceTime / BenchmarkFrames;
+		bBenchmarkThrottled = true;
+		bSignificanceEnabled = true;
+		BenchmarkWarmupRemaining = BenchmarkWarmupFrames;
+		BenchmarkFrames = 0;
+		BenchmarkFrameTime = 0.0;
+		BenchmarkSignificanceTime = 0.0;
+		return;
+	}
+
+	const double ThrottledFrameTime = BenchmarkFrameTime / BenchmarkFrames;
+	UE_LOG(LogTemp, Display, TEXT("[EnemySignificance] Benchmark: %d enemies, %d frames per phase. Unthrottled: avg frame %.3f ms, avg significance update %.3f ms. ")
+		TEXT("Throttled: avg frame %.3f ms, avg significance update %.3f ms (%.2fx)"),
+		Enemies.Num(),
+		BenchmarkFrames,
+		BenchmarkBaselineFrameTime * 1000.0,
+		BenchmarkBaselineSignificanceTime * 1000.0,
+		ThrottledFrameTime * 1000.0,
+		BenchmarkSignificanceTime * 1000.0 / BenchmarkFrames,
+		ThrottledFrameTime > 0.0 ? BenchmarkBaselineFrameTime / ThrottledFrameTime : 0.0);
+
+	for (const TWeakObjectPtr<ATPSTemplate_Enemy_Base>& Enemy : BenchmarkEnemies)
+	{
+		if (Enemy.IsValid())
+		{
+			Enemy->Destroy();
+		}
+	}
+	BenchmarkEnemies.Reset();
+
+	bSignificanceEnabled = bBenchmarkSavedEnabled;
+	BenchmarkTargetFrames = 0;
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemySignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,343 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/FlowFieldSubsystem.h"
+#include "TPSTemplate.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavigationPath.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Build"), STAT_FlowFieldBuild, STATGROUP_TPSTemplate);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Path"), STAT_FlowFieldPath, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Builds"), STAT_FlowFieldBuilds, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Paths (queries avoided)"), STAT_FlowFieldPaths, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Misses"), STAT_FlowFieldMisses, STATGROUP_TPSTemplate);
+
+namespace
+{
+	constexpr float UnwalkableHeight = TNumericLimits<float>::Lowest();
+
+	/** Vertical reach of the navmesh projection of a cell centre */
+	constexpr float ProjectionHalfHeight = 250.f;
+
+	// 8-neighbourhood; diagonals cost sqrt(2) cells
+	constexpr int32 NeighbourX[] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	constexpr int32 NeighbourY[] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+	constexpr float NeighbourCost[] = { 1.f, 1.f, 1.f, 1.f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2 };
+	constexpr int32 NumNeighbours = UE_ARRAY_COUNT(NeighbourX);
+
+	FAutoConsoleCommandWithWorldAndArgs FlowFieldBenchmarkCommand(
+		TEXT("tps.AI.FlowFieldBenchmark"),
+		TEXT("tps.AI.FlowFieldBenchmark [Agents=200]: compare per-agent navmesh path queries with flow-field paths to the player."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UFlowFieldSubsystem* FlowFields = World ? World->GetSubsystem<UFlowFieldSubsystem>() : nullptr;
+			if (!FlowFields)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[FlowField] tps.AI.FlowFieldBenchmark needs a game world"));
+				return;
+			}
+			FlowFields->RunBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200);
+		}),
+		ECVF_Cheat
+	);
+}
+
+bool UFlowFieldSubsystem::FindPathToTarget(const AActor* Target, const FVector& From, TArray<FVector>& OutPathPoints, uint32* OutFieldVersion)
+{
+	OutPathPoints.Reset();
+
+	const FFlowField* Field = GetField(Target);
+	if (!Field)
+	{
+		INC_DWORD_STAT(STAT_FlowFieldMisses);
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldPath);
+
+	const FIntPoint Cell = ToWorldCell(From) - Field->Origin;
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= GridSize || Cell.Y >= GridSize)
+	{
+		INC_DWORD_STAT(STAT_FlowFieldMisses);
+		return false;
+	}
+
+	int32 Index = Cell.Y * GridSize + Cell.X;
+	if (Field->Distance[Index] == MAX_flt)
+	{
+		INC_DWORD_STAT(STAT_FlowFieldMisses);
+		return false;
+	}
+
+	// Follow Next to the target, keeping only the cells where the direction changes
+	OutPathPoints.Add(From);
+	int32 LastStep = INDEX_NONE;
+	while (Field->Next[Index] != INDEX_NONE)
+	{
+		const int32 NextIndex = Field->Next[Index];
+		const int32 Step = NextIndex - Index;
+		if (LastStep != INDEX_NONE && Step != LastStep)
+		{
+			const FIntPoint WorldCell = Field->Origin + FIntPoint(Index % GridSize, Index / GridSize);
+			const float* Height = GetFieldCellHeight(*Field, WorldCell, From.Z);
+			OutPathPoints.Emplace((WorldCell.X + 0.5f) * CellSize, (WorldCell.Y + 0.5f) * CellSize, Height ? *Height : From.Z);
+		}
+		LastStep = Step;
+		Index = NextIndex;
+	}
+	OutPathPoints.Add(Target->GetActorLocation());
+
+	if (OutFieldVersion)
+	{
+		*OutFieldVersion = Field->Version;
+	}
+
+	INC_DWORD_STAT(STAT_FlowFieldPaths);
+	return true;
+}
+
+bool UFlowFieldSubsystem::IsPathStale(const AActor* Target, uint32 FieldVersion) const
+{
+	const FFlowField* Field = Target ? Fields.Find(Target) : nullptr;
+	if (!Field || Field->Version != FieldVersion)
+	{
+		return true;
+	}
+
+	// Same test GetField rebuilds on
+	const FVector TargetLocation = Target->GetActorLocation();
+	return ToWorldCell(TargetLocation) != ToWorldCell(Field->TargetLocation)
+		|| FMath::Abs(TargetLocation.Z - Field->TargetLocation.Z) > ProjectionHalfHeight;
+}
+
+const UFlowFieldSubsystem::FFlowField* UFlowFieldSubsystem::GetField(const AActor* Target)
+{
+	if (!Target)
+	{
+		return nullptr;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Fields.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid() || Now - It->Value.LastUsedTime > FieldLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Rebuild once the target left the cell the field was built around
+	const FVector TargetLocation = Target->GetActorLocation();
+	FFlowField& Field = Fields.FindOrAdd(Target);
+	if (Field.Distance.Num() == 0
+		|| ToWorldCell(TargetLocation) != ToWorldCell(Field.TargetLocation)
+		|| FMath::Abs(TargetLocation.Z - Field.TargetLocation.Z) > ProjectionHalfHeight)
+	{
+		BuildField(Field, TargetLocation);
+	}
+	Field.LastUsedTime = Now;
+
+	return Field.Distance.Num() > 0 ? &Field : nullptr;
+}
+
+void UFlowFieldSubsystem::BuildField(FFlowField& Field, const FVector& TargetLocation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldBuild);
+	INC_DWORD_STAT(STAT_FlowFieldBuilds);
+
+	constexpr int32 NumCells = GridSize * GridSize;
+	Field.TargetLocation = TargetLocation;
+	Field.Origin = ToWorldCell(TargetLocation) - FIntPoint(GridSize / 2, GridSize / 2);
+	Field.Version = NextFieldVersion++;
+	Field.Distance.Init(MAX_flt, NumCells);
+	Field.Next.Init(INDEX_NONE, NumCells);
+
+	// Target is off the navmesh (jumping, on a prop) - path to it from the cell underneath anyway,
+	// without marking the cell walkable for other fields
+	const int32 TargetIndex = (GridSize / 2) * GridSize + (GridSize / 2);
+	Field.bTargetCellOverride = !GetCellHeight(Field.Origin + FIntPoint(GridSize / 2, GridSize / 2), TargetLocation.Z);
+	Field.TargetCellHeight = TargetLocation.Z;
+
+	// Dijkstra outward from the target; Next points back along the cheapest edge
+	TArray<TPair<float, int32>> Open;
+	Open.Reserve(NumCells / 4);
+	auto HeapLess = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; };
+
+	Field.Distance[TargetIndex] = 0.f;
+	Open.HeapPush(TPair<float, int32>(0.f, TargetIndex), HeapLess);
+
+	while (Open.Num() > 0)
+	{
+		TPair<float, int32> Current;
+		Open.HeapPop(Current, HeapLess, EAllowShrinking::No);
+		const int32 Index = Current.Value;
+		if (Current.Key > Field.Distance[Index])
+		{
+			continue;
+		}
+
+		const int32 X = Index % GridSize;
+		const int32 Y = Index / GridSize;
+		const float Height = *GetFieldCellHeight(Field, Field.Origin + FIntPoint(X, Y), TargetLocation.Z);
+
+		for (int32 n = 0; n < NumNeighbours; ++n)
+		{
+			const int32 NX = X + NeighbourX[n];
+			const int32 NY = Y + NeighbourY[n];
+			if (NX < 0 || NY < 0 || NX >= GridSize || NY >= GridSize)
+			{
+				continue;
+			}
+
+			const float* NeighbourHeight = GetFieldCellHeight(Field, Field.Origin + FIntPoint(NX, NY), Height);
+			if (!NeighbourHeight || FMath::Abs(*NeighbourHeight - Height) > MaxStepHeight)
+			{
+				continue;
+			}
+
+			// No corner cutting: a diagonal needs both orthogonal cells open
+			if (n >= 4 && (!GetFieldCellHeight(Field, Field.Origin + FIntPoint(NX, Y), Height) || !GetFieldCellHeight(Field, Field.Origin + FIntPoint(X, NY), Height)))
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = NY * GridSize + NX;
+			const float NewDistance = Current.Key + NeighbourCost[n];
+			if (NewDistance < Field.Distance[NeighbourIndex])
+			{
+				Field.Distance[NeighbourIndex] = NewDistance;
+				Field.Next[NeighbourIndex] = Index;
+				Open.HeapPush(TPair<float, int32>(NewDistance, NeighbourIndex), HeapLess);
+			}
+		}
+	}
+}
+
+const float* UFlowFieldSubsystem::GetCellHeight(const FIntPoint& WorldCell, float ReferenceZ)
+{
+	if (const float* Cached = CellHeights.Find(WorldCell))
+	{
+		return *Cached == UnwalkableHeight ? nullptr : Cached;
+	}
+
+	float Height = UnwalkableHeight;
+	if (const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		const FVector CellCenter((WorldCell.X + 0.5f) * CellSize, (WorldCell.Y + 0.5f) * CellSize, ReferenceZ);
+		FNavLocation Projected;
+		if (NavSys->ProjectPointToNavigation(CellCenter, Projected, FVector(CellSize * 0.5f, CellSize * 0.5f, ProjectionHalfHeight)))
+		{
+			Height = Projected.Location.Z;
+		}
+	}
+
+	const float& Stored = CellHeights.Add(WorldCell, Height);
+	return Stored == UnwalkableHeight ? nullptr : &Stored;
+}
+
+const float* UFlowFieldSubsystem::GetFieldCellHeight(const FFlowField& Field, const FIntPoint& WorldCell, float ReferenceZ)
+{
+	if (Field.bTargetCellOverride && WorldCell == Field.Origin + FIntPoint(GridSize / 2, GridSize / 2))
+	{
+		return &Field.TargetCellHeight;
+	}
+	return GetCellHeight(WorldCell, ReferenceZ);
+}
+
+FIntPoint UFlowFieldSubsystem::ToWorldCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UFlowFieldSubsystem::RunBenchmark(int32 NumAgents)
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const APlayerController* PC = World->GetFirstPlayerController();
+	const APawn* Target = PC ? PC->GetPawn() : nullptr;
+	if (!NavSys || !Target)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[FlowField] Benchmark needs a navmesh and a player pawn"));
+		return;
+	}
+
+	// Start points a swarm would chase from, inside the field
+	const FVector TargetLocation = Target->GetActorLocation();
+	const float Radius = GridSize * CellSize * 0.4f;
+	TArray<FVector> Starts;
+	for (int32 i = 0; i < NumAgents; ++i)
+	{
+		FNavLocation Start;
+		if (NavSys->GetRandomReachablePointInRadius(TargetLocation, Radius, Start))
+		{
+			Starts.Add(Start.Location);
+		}
+	}
+
+	// Per-agent: one navmesh query each
+	int32 NumQueries = 0;
+	int32 NumQueryPaths = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Start : Starts)
+	{
+		++NumQueries;
+		const UNavigationPath* Path = NavSys->FindPathToLocationSynchronously(World, Start, TargetLocation);
+		NumQueryPaths += (Path && Path->IsValid()) ? 1 : 0;
+	}
+	const double QueryTime = FPlatformTime::Seconds() - StartTime;
+
+	// Flow field: a cold build (empty height cache), then every agent walks it
+	Fields.Remove(Target);
+	CellHeights.Reset();
+	TArray<FVector> Points;
+	int32 NumFieldPaths = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (const FVector& Start : Starts)
+	{
+		NumFieldPaths += FindPathToTarget(Target, Start, Points) ? 1 : 0;
+	}
+	const double FieldTime = FPlatformTime::Seconds() - StartTime;
+
+	// Warm rebuild, as after the target moved a cell
+	Fields.Remove(Target);
+	StartTime = FPlatformTime::Seconds();
+	GetField(Target);
+	const double RebuildTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("[FlowField] Benchmark %d agents: path queries %d (%d found) %.3f ms | flow field 0 queries (%d paths) %.3f ms incl. cold build, warm rebuild %.3f ms"),
+		Starts.Num(), NumQueries, NumQueryPaths, QueryTime * 1000.0, NumFieldPaths, FieldTime * 1000.0, RebuildTime * 1000.0);
+}
+
+void UFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void UFlowFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// Walkability changed - heights and fields are rebuilt on the next request
+	CellHeights.Reset();
+	Fields.Reset();
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	Fields.Empty();
+	CellHeights.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
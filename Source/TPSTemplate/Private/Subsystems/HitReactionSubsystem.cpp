@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/HitReactionSubsystem.h"
+#include "TPSTemplate.h"
+#include "Components/Hurtbox.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hit Reaction Tick"), STAT_HitReactionTick, STATGROUP_TPSTemplate);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hit Reaction Bodies Simulated"), STAT_HitReactionBodies, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Reactions Merged"), STAT_HitReactionsMerged, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Reactions Evicted"), STAT_HitReactionsEvicted, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Reactions Skipped (LOD)"), STAT_HitReactionsSkipped, STATGROUP_TPSTemplate);
+
+namespace
+{
+	int32 MaxSimulatedBodies = 8;
+
+	FAutoConsoleVariableRef CVarHitReactionMaxBodies(
+		TEXT("tps.HitReaction.MaxBodies"),
+		MaxSimulatedBodies,
+		TEXT("Maximum number of bodies simulating a physical hit reaction at once, across all characters."),
+		ECVF_Scalability
+	);
+
+	float MaxReactionDistance = 3000.0f;
+
+	FAutoConsoleVariableRef CVarHitReactionMaxDistance(
+		TEXT("tps.HitReaction.MaxDistance"),
+		MaxReactionDistance,
+		TEXT("Hits farther than this from the local camera play no physical reaction (0 disables the distance check)."),
+		ECVF_Scalability
+	);
+}
+
+bool FHitReactionBudget::Merge(const UHurtbox* Hurtbox, FName BoneName, double Now, float Duration, float MaxDuration)
+{
+	for (FActiveReaction& Reaction : Reactions)
+	{
+		if (Reaction.Hurtbox.Get() == Hurtbox && Reaction.BoneName == BoneName)
+		{
+			Reaction.ExpireTime = FMath::Min(FMath::Max(Reaction.ExpireTime, Now + Duration), Reaction.StartTime + MaxDuration);
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FHitReactionBudget::FindEviction(int32 MaxBodies) const
+{
+	if (Reactions.Num() == 0 || Reactions.Num() < MaxBodies)
+	{
+		return INDEX_NONE;
+	}
+
+	// The reaction closest to recovering is the least visible
+	int32 SoonestIndex = 0;
+	for (int32 i = 1; i < Reactions.Num(); ++i)
+	{
+		if (Reactions[i].ExpireTime < Reactions[SoonestIndex].ExpireTime)
+		{
+			SoonestIndex = i;
+		}
+	}
+	return SoonestIndex;
+}
+
+void FHitReactionBudget::Add(UHurtbox* Hurtbox, FName BoneName, double Now, float Duration)
+{
+	FActiveReaction& Reaction = Reactions.AddDefaulted_GetRef();
+	Reaction.Hurtbox = Hurtbox;
+	Reaction.BoneName = BoneName;
+	Reaction.StartTime = Now;
+	Reaction.ExpireTime = Now + Duration;
+}
+
+EHitReactionRequest UHitReactionSubsystem::RequestReaction(UHurtbox* Hurtbox, FName BoneName, const FVector& HitLocation, float Duration, float MaxDuration)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// A bone that is already simulating just keeps going for longer
+	if (Budget.Merge(Hurtbox, BoneName, Now, Duration, MaxDuration))
+	{
+		INC_DWORD_STAT(STAT_HitReactionsMerged);
+		return EHitReactionRequest::Merged;
+	}
+
+	if (MaxSimulatedBodies <= 0 || !IsWithinReactionRange(Hurtbox, HitLocation))
+	{
+		INC_DWORD_STAT(STAT_HitReactionsSkipped);
+		return EHitReactionRequest::Skipped;
+	}
+
+	// Over budget: end the reactions closest to recovering to make room
+	for (int32 Evict = Budget.FindEviction(MaxSimulatedBodies); Evict != INDEX_NONE; Evict = Budget.FindEviction(MaxSimulatedBodies))
+	{
+		EndReactionAt(Evict);
+		INC_DWORD_STAT(STAT_HitReactionsEvicted);
+	}
+
+	Budget.Add(Hurtbox, BoneName, Now, Duration);
+
+	SET_DWORD_STAT(STAT_HitReactionBodies, Budget.Reactions.Num());
+	return EHitReactionRequest::Started;
+}
+
+void UHitReactionSubsystem::ReleaseAll(UHurtbox* Hurtbox)
+{
+	for (int32 i = Budget.Reactions.Num() - 1; i >= 0; --i)
+	{
+		if (Budget.Reactions[i].Hurtbox.Get() == Hurtbox)
+		{
+			EndReactionAt(i);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_HitReactionBodies, Budget.Reactions.Num());
+}
+
+bool UHitReactionSubsystem::IsWithinReactionRange(const UHurtbox* Hurtbox, const FVector& HitLocation) const
+{
+	const ACharacter* OwnerCharacter = Hurtbox ? Cast<ACharacter>(Hurtbox->GetOwner()) : nullptr;
+	const USkeletalMeshComponent* Mesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+	if (!Mesh || !Mesh->WasRecentlyRendered(0.2f))
+	{
+		return false;
+	}
+
+	if (MaxReactionDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	// Without a local camera (dedicated server) there is nobody to see the reaction
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		return false;
+	}
+
+	const FVector CameraLocation = PC->PlayerCameraManager->GetCameraLocation();
+	return FVector::DistSquared(CameraLocation, HitLocation) <= FMath::Square(MaxReactionDistance);
+}
+
+void UHitReactionSubsystem::EndReactionAt(int32 Index)
+{
+	const FHitReactionBudget::FActiveReaction Reaction = Budget.Reactions[Index];
+	Budget.Reactions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (UHurtbox* Hurtbox = Reaction.Hurtbox.Get())
+	{
+		Hurtbox->EndBoneReaction(Reaction.BoneName);
+	}
+}
+
+void UHitReactionSubsystem::Deinitialize()
+{
+	Budget.Reactions.Empty();
+	SET_DWORD_STAT(STAT_HitReactionBodies, 0);
+
+	Super::Deinitialize();
+}
+
+void UHitReactionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitReactionTick);
+
+	if (Budget.Reactions.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 i = Budget.Reactions.Num() - 1; i >= 0; --i)
+	{
+		if (!Budget.Reactions[i].Hurtbox.IsValid() || Budget.Reactions[i].ExpireTime <= Now)
+		{
+			EndReactionAt(i);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_HitReactionBodies, Budget.Reactions.Num());
+}
+
+TStatId UHitReactionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitReactionSubsystem, STATGROUP_Tickables);
+}
+
+bool UHitReactionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
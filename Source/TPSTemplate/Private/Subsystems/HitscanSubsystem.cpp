@@ -0,0 +1,279 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/HitscanSubsystem.h"
+#include "TPSTemplate.h"
+#include "Weapon/MasterWeapon.h"
+#include "Components/WeaponSystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hitscan Resolve Batch"), STAT_HitscanResolveBatch, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Traces Queued"), STAT_HitscanTracesQueued, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Resolved"), STAT_HitscanShotsResolved, STATGROUP_TPSTemplate);
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs HitscanBenchmarkCommand(
+		TEXT("tps.Weapon.HitscanBenchmark"),
+		TEXT("tps.Weapon.HitscanBenchmark [Weapons=64] [Pellets=8] [Frames=120]: game-thread cost of N weapons firing every frame, synchronous traces vs the async batch."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UHitscanSubsystem* Hitscan = World ? World->GetSubsystem<UHitscanSubsystem>() : nullptr;
+			if (!Hitscan)
+			{
+				UE_LOG(LogTPSWeapon, Warning, TEXT("[Hitscan] tps.Weapon.HitscanBenchmark needs a game world"));
+				return;
+			}
+
+			const int32 Weapons = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+			const int32 Pellets = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 8;
+			const int32 Frames = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 120;
+			Hitscan->RunBenchmark(Weapons, Pellets, Frames);
+		}),
+		ECVF_Cheat
+	);
+
+	/** Range and pellet spread of the benchmark shots */
+	constexpr float BenchmarkRange = 10000.f;
+	constexpr float BenchmarkSpreadDegrees = 4.f;
+
+	/** The old pipeline started its muzzle and pellet traces this far in front of the camera */
+	constexpr float BenchmarkMuzzleOffset = 100.f;
+}
+
+void UHitscanSubsystem::QueueAimTrace(AMasterWeapon* Weapon, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	QueueTraces(Weapon, EStage::Aim, Start, MakeArrayView(&End, 1), Channel, Params);
+}
+
+void UHitscanSubsystem::QueuePelletTraces(AMasterWeapon* Weapon, const FVector& Start, TConstArrayView<FVector> Ends, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	QueueTraces(Weapon, EStage::Pellets, Start, Ends, Channel, Params);
+}
+
+void UHitscanSubsystem::QueueTraces(AMasterWeapon* Weapon, EStage Stage, const FVector& Start, TConstArrayView<FVector> Ends, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	UWorld* World = GetWorld();
+
+	FPendingShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Weapon = Weapon;
+	Shot.Stage = Stage;
+	Shot.Start = Start;
+	Shot.Ends = Ends;
+	Shot.SubmitFrame = GFrameCounter;
+	Shot.Handles.Reserve(Ends.Num());
+	for (const FVector& End : Ends)
+	{
+		Shot.Handles.Add(World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Channel, Params));
+	}
+
+	INC_DWORD_STAT_BY(STAT_HitscanTracesQueued, Ends.Num());
+}
+
+void UHitscanSubsystem::RunBenchmark(int32 NumWeapons, int32 NumPellets, int32 NumFrames)
+{
+	if (BenchmarkFramesRemaining > 0 || BenchmarkHandles.Num() > 0)
+	{
+		UE_LOG(LogTPSWeapon, Warning, TEXT("[Hitscan] Benchmark already running"));
+		return;
+	}
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		UE_LOG(LogTPSWeapon, Warning, TEXT("[Hitscan] Benchmark needs a local player camera"));
+		return;
+	}
+
+	BenchmarkWeapons = FMath::Max(NumWeapons, 1);
+	BenchmarkPellets = FMath::Max(NumPellets, 1);
+	BenchmarkFramesRemaining = FMath::Max(NumFrames, 1);
+	BenchmarkFrames = 0;
+	BenchmarkSyncTime = 0.0;
+	BenchmarkAsyncTime = 0.0;
+
+	// Every weapon aims somewhere inside the view, its pellets spread around that; the same shots repeat each frame
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	BenchmarkStart = ViewLocation;
+
+	FRandomStream Random(7);
+	const FVector Forward = ViewRotation.Vector();
+	BenchmarkEnds.Reset(BenchmarkWeapons * (1 + BenchmarkPellets));
+	for (int32 WeaponIndex = 0; WeaponIndex < BenchmarkWeapons; ++WeaponIndex)
+	{
+		const FVector AimDirection = Random.VRandCone(Forward, FMath::DegreesToRadians(20.f));
+		BenchmarkEnds.Add(BenchmarkStart + AimDirection * BenchmarkRange);
+		for (int32 Pellet = 0; Pellet < BenchmarkPellets; ++Pellet)
+		{
+			BenchmarkEnds.Add(BenchmarkStart + Random.VRandCone(AimDirection, FMath::DegreesToRadians(BenchmarkSpreadDegrees)) * BenchmarkRange);
+		}
+	}
+
+	UE_LOG(LogTPSWeapon, Display, TEXT("[Hitscan] Benchmark: %d weapons x %d pellets, %d frames"), BenchmarkWeapons, BenchmarkPellets, BenchmarkFramesRemaining);
+}
+
+void UHitscanSubsystem::TickBenchmark()
+{
+	UWorld* World = GetWorld();
+	const APlayerController* PC = World->GetFirstPlayerController();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(HitscanBenchmark), false, PC ? PC->GetPawn() : nullptr);
+
+	const int32 Stride = 1 + BenchmarkPellets;
+	const bool bFireThisFrame = BenchmarkFramesRemaining > 0;
+
+	if (bFireThisFrame)
+	{
+		// Old pipeline: camera trace, discarded muzzle trace, one trace per pellet, all blocking
+		const double SyncStart = FPlatformTime::Seconds();
+		FHitResult Hit;
+		for (int32 WeaponIndex = 0; WeaponIndex < BenchmarkWeapons; ++WeaponIndex)
+		{
+			const FVector& AimEnd = BenchmarkEnds[WeaponIndex * Stride];
+			const FVector MuzzleStart = BenchmarkStart + (AimEnd - BenchmarkStart).GetSafeNormal() * BenchmarkMuzzleOffset;
+			World->LineTraceSingleByChannel(Hit, BenchmarkStart, AimEnd, ECC_Visibility, Params);
+			World->LineTraceSingleByChannel(Hit, MuzzleStart, AimEnd, COLLISION_BULLET, Params);
+			for (int32 Pellet = 1; Pellet < Stride; ++Pellet)
+			{
+				World->LineTraceSingleByChannel(Hit, MuzzleStart, BenchmarkEnds[WeaponIndex * Stride + Pellet], COLLISION_BULLET, Params);
+			}
+		}
+		BenchmarkSyncTime += FPlatformTime::Seconds() - SyncStart;
+	}
+
+	// Batched pipeline: read last frame's results, queue this frame's aim and pellet traces
+	const double AsyncStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < BenchmarkHandles.Num(); ++i)
+	{
+		ReadTrace(BenchmarkHandles[i], BenchmarkStart, BenchmarkEnds[i]);
+	}
+	BenchmarkHandles.Reset();
+
+	if (bFireThisFrame)
+	{
+		for (int32 i = 0; i < BenchmarkEnds.Num(); ++i)
+		{
+			const bool bAim = (i % Stride) == 0;
+			BenchmarkHandles.Add(World->AsyncLineTraceByChannel(EAsyncTraceType::Single, BenchmarkStart, BenchmarkEnds[i],
+				bAim ? ECC_Visibility : COLLISION_BULLET, Params));
+		}
+	}
+	BenchmarkAsyncTime += FPlatformTime::Seconds() - AsyncStart;
+
+	if (bFireThisFrame)
+	{
+		--BenchmarkFramesRemaining;
+		++BenchmarkFrames;
+		return;
+	}
+
+	// Last results read: report
+	UE_LOG(LogTPSWeapon, Display, TEXT("[Hitscan] Benchmark: %d weapons x %d pellets over %d frames, game thread %.3f ms/frame sync (%d traces), %.3f ms/frame async (%d traces)"),
+		BenchmarkWeapons, BenchmarkPellets, BenchmarkFrames,
+		BenchmarkSyncTime * 1000.0 / BenchmarkFrames, BenchmarkWeapons * (2 + BenchmarkPellets),
+		BenchmarkAsyncTime * 1000.0 / BenchmarkFrames, BenchmarkWeapons * (1 + BenchmarkPellets));
+}
+
+void UHitscanSubsystem::Deinitialize()
+{
+	PendingShots.Empty();
+	BenchmarkHandles.Empty();
+	BenchmarkFramesRemaining = 0;
+
+	Super::Deinitialize();
+}
+
+void UHitscanSubsystem::Tick(float DeltaTime)
+{
+	if (BenchmarkFramesRemaining > 0 || BenchmarkHandles.Num() > 0)
+	{
+		TickBenchmark();
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_HitscanResolveBatch);
+
+	if (PendingShots.Num() == 0)
+	{
+		return;
+	}
+
+	// Take everything submitted before this frame; weapons queue their pellet batches back into PendingShots
+	TArray<FPendingShot> ReadyShots;
+	int32 NumWaiting = 0;
+	for (int32 i = 0; i < PendingShots.Num(); ++i)
+	{
+		if (PendingShots[i].SubmitFrame < GFrameCounter)
+		{
+			ReadyShots.Add(MoveTemp(PendingShots[i]));
+		}
+		else
+		{
+			if (i != NumWaiting)
+			{
+				PendingShots[NumWaiting] = MoveTemp(PendingShots[i]);
+			}
+			++NumWaiting;
+		}
+	}
+	PendingShots.SetNum(NumWaiting, EAllowShrinking::No);
+
+	TArray<FHitResult, TInlineAllocator<8>> Hits;
+	for (const FPendingShot& Shot : ReadyShots)
+	{
+		AMasterWeapon* Weapon = Shot.Weapon.Get();
+		if (!Weapon)
+		{
+			continue;
+		}
+
+		Hits.Reset();
+		for (int32 i = 0; i < Shot.Handles.Num(); ++i)
+		{
+			Hits.Add(ReadTrace(Shot.Handles[i], Shot.Start, Shot.Ends[i]));
+		}
+
+		if (Shot.Stage == EStage::Aim)
+		{
+			Weapon->OnAimTraceComplete(Hits[0]);
+		}
+		else
+		{
+			Weapon->OnPelletTracesComplete(Shot.Start, Hits);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_HitscanShotsResolved, ReadyShots.Num());
+}
+
+TStatId UHitscanSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitscanSubsystem, STATGROUP_Tickables);
+}
+
+bool UHitscanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FHitResult UHitscanSubsystem::ReadTrace(const FTraceHandle& Handle, const FVector& Start, const FVector& End) const
+{
+	FTraceDatum Datum;
+	if (GetWorld()->QueryTraceData(Handle, Datum))
+	{
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				return Hit;
+			}
+		}
+	}
+
+	// Miss: same shape a LineTraceSingle miss reports
+	FHitResult Miss(Start, End);
+	Miss.Location = End;
+	return Miss;
+}
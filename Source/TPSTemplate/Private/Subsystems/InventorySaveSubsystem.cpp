@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InventorySaveSubsystem.h"
+#include "Characters/TPSTemplateCharacter.h"
+#include "Components/InventorySystem.h"
+#include "Components/EquipmentSystem.h"
+#include "Data/InventorySaveData.h"
+#include "Engine/AssetManager.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+bool UInventorySaveSubsystem::SaveCharacter(ATPSTemplateCharacter* Character, const FString& SlotName)
+{
+	if (!Character || !Character->GetInventorySystem())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySaveSubsystem] SaveCharacter: Character or InventorySystem is NULL"));
+		return false;
+	}
+
+	FInventorySaveData Data;
+	Character->GetInventorySystem()->WriteSaveData(Data);
+	if (UEquipmentSystem* EquipmentSystem = Character->GetEquipmentSystem())
+	{
+		EquipmentSystem->WriteSaveData(Data);
+	}
+
+	TArray<uint8> Bytes;
+	if (!Data.SaveToBytes(Bytes))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[InventorySaveSubsystem] SaveCharacter: Failed to serialize slot %s"), *SlotName);
+		return false;
+	}
+
+	// Only the file write leaves the game thread; the snapshot above is already a plain byte buffer
+	Async(EAsyncExecution::ThreadPool, [Bytes = MoveTemp(Bytes), FilePath = GetSaveFilePath(SlotName)]()
+	{
+		if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[InventorySaveSubsystem] Failed to write %s"), *FilePath);
+		}
+	});
+
+	UE_LOG(LogTemp, Log, TEXT("[InventorySaveSubsystem] Saved %d slots, %d equipment, %d assets to %s"),
+		Data.Slots.Num(), Data.Equipment.Num(), Data.Assets.Num(), *SlotName);
+	return true;
+}
+
+void UInventorySaveSubsystem::LoadCharacterAsync(ATPSTemplateCharacter* Character, const FString& SlotName, FOnInventoryLoadComplete OnComplete)
+{
+	if (!Character || !Character->GetInventorySystem())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[InventorySaveSubsystem] LoadCharacterAsync: Character or InventorySystem is NULL"));
+		OnComplete.ExecuteIfBound(false);
+		return;
+	}
+
+	TWeakObjectPtr<UInventorySaveSubsystem> WeakThis(this);
+	TWeakObjectPtr<ATPSTemplateCharacter> WeakCharacter(Character);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, WeakCharacter, OnComplete, FilePath = GetSaveFilePath(SlotName)]()
+	{
+		TArray<uint8> Bytes;
+		TSharedRef<FInventorySaveData> Data = MakeShared<FInventorySaveData>();
+		const bool bParsed = FFileHelper::LoadFileToArray(Bytes, *FilePath) && Data->LoadFromBytes(Bytes);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakCharacter, OnComplete, Data, bParsed, FilePath]()
+		{
+			if (!bParsed || !WeakThis.IsValid())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[InventorySaveSubsystem] Failed to load %s"), *FilePath);
+				OnComplete.ExecuteIfBound(false);
+				return;
+			}
+			WeakThis->ApplyLoadedData(WeakCharacter, Data, OnComplete);
+		});
+	});
+}
+
+void UInventorySaveSubsystem::ApplyLoadedData(TWeakObjectPtr<ATPSTemplateCharacter> WeakCharacter, TSharedRef<FInventorySaveData> Data, FOnInventoryLoadComplete OnComplete)
+{
+	auto Apply = [WeakCharacter, Data, OnComplete]()
+	{
+		ATPSTemplateCharacter* Character = WeakCharacter.Get();
+		if (!Character || !Character->GetInventorySystem())
+		{
+			OnComplete.ExecuteIfBound(false);
+			return;
+		}
+
+		Character->GetInventorySystem()->ApplySaveData(*Data);
+		if (UEquipmentSystem* EquipmentSystem = Character->GetEquipmentSystem())
+		{
+			EquipmentSystem->ApplySaveData(*Data);
+		}
+		OnComplete.ExecuteIfBound(true);
+	};
+
+	// Stream every referenced item asset in one request, then apply once they are all resident
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAssets(Data->Assets);
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		Apply();
+		return;
+	}
+	Handle->BindCompleteDelegate(FStreamableDelegate::CreateLambda(MoveTemp(Apply)));
+}
+
+bool UInventorySaveSubsystem::DoesSaveExist(const FString& SlotName) const
+{
+	return IFileManager::Get().FileExists(*GetSaveFilePath(SlotName));
+}
+
+FString UInventorySaveSubsystem::GetSaveFilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / (SlotName + TEXT(".inv"));
+}
@@ -0,0 +1,231 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/NoiseEventSubsystem.h"
+#include "TPSTemplate.h"
+#include "Perception/AISense_Hearing.h"
+#include "Perception/AISenseConfig_Hearing.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Noise Events Flush"), STAT_NoiseEventsFlush, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Events Reported"), STAT_NoiseEventsReported, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Events Coalesced"), STAT_NoiseEventsCoalesced, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Events Inaudible"), STAT_NoiseEventsInaudible, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Events Forwarded"), STAT_NoiseEventsForwarded, STATGROUP_TPSTemplate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Listeners Tested"), STAT_NoiseListenersTested, STATGROUP_TPSTemplate);
+
+namespace
+{
+	float NoiseWindow = 0.25f;
+
+	FAutoConsoleVariableRef CVarNoiseWindow(
+		TEXT("tps.AI.NoiseWindow"),
+		NoiseWindow,
+		TEXT("Seconds over which noise from one instigator is merged into a single hearing event (0 reports every event)."),
+		ECVF_Default
+	);
+
+	/** Listener pawns move; the grid is re-binned at most this often */
+	constexpr double GridRefreshInterval = 0.2;
+}
+
+void UNoiseEventSubsystem::ReportNoise(AActor* Instigator, const FVector& Location, float Loudness, float MaxRange, FName Tag)
+{
+	INC_DWORD_STAT(STAT_NoiseEventsReported);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	FNoiseChannel* Channel = Channels.FindByPredicate([Instigator, Tag](const FNoiseChannel& Entry)
+	{
+		return Entry.Instigator.Get() == Instigator && Entry.Tag == Tag;
+	});
+
+	// Window open: fold into the event sent when it closes
+	if (Channel && Now < Channel->WindowEnd)
+	{
+		if (Channel->bPending)
+		{
+			INC_DWORD_STAT(STAT_NoiseEventsCoalesced);
+			Channel->Loudness = FMath::Max(Channel->Loudness, Loudness);
+			Channel->MaxRange = (Channel->MaxRange > 0.f && MaxRange > 0.f) ? FMath::Max(Channel->MaxRange, MaxRange) : 0.f;
+		}
+		else
+		{
+			Channel->bPending = true;
+			Channel->Loudness = Loudness;
+			Channel->MaxRange = MaxRange;
+		}
+		Channel->Location = Location;
+		return;
+	}
+
+	if (!Channel)
+	{
+		Channel = &Channels.AddDefaulted_GetRef();
+		Channel->Instigator = Instigator;
+		Channel->Tag = Tag;
+	}
+	Channel->WindowEnd = Now + NoiseWindow;
+	Channel->bPending = false;
+
+	EmitNoise(Instigator, Location, Loudness, MaxRange, Tag);
+}
+
+void UNoiseEventSubsystem::EmitNoise(AActor* Instigator, const FVector& Location, float Loudness, float MaxRange, FName Tag)
+{
+	if (!IsAudible(Location, Loudness, MaxRange))
+	{
+		INC_DWORD_STAT(STAT_NoiseEventsInaudible);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_NoiseEventsForwarded);
+	UAISense_Hearing::ReportNoiseEvent(GetWorld(), Location, Loudness, Instigator, MaxRange, Tag);
+}
+
+bool UNoiseEventSubsystem::IsAudible(const FVector& Location, float Loudness, float MaxRange)
+{
+	RefreshGrid();
+
+	if (Grid.Num() == 0)
+	{
+		return false;
+	}
+
+	// Same reach test as the hearing sense: HearingRange scaled by loudness, clamped by the event's MaxRange
+	float QueryRadius = MaxHearingRange * Loudness;
+	if (MaxRange > 0.f)
+	{
+		QueryRadius = FMath::Min(QueryRadius, MaxRange);
+	}
+
+	const FIntPoint Center = GetCell(Location);
+	const int32 CellRadius = FMath::CeilToInt(QueryRadius / CellSize);
+	for (int32 Y = Center.Y - CellRadius; Y <= Center.Y + CellRadius; ++Y)
+	{
+		for (int32 X = Center.X - CellRadius; X <= Center.X + CellRadius; ++X)
+		{
+			const TArray<int32>* Cell = Grid.Find(FIntPoint(X, Y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 ListenerIndex : *Cell)
+			{
+				INC_DWORD_STAT(STAT_NoiseListenersTested);
+
+				const FListener& Listener = Listeners[ListenerIndex];
+				float Reach = Listener.HearingRange * Loudness;
+				if (MaxRange > 0.f)
+				{
+					Reach = FMath::Min(Reach, MaxRange);
+				}
+				if (FVector::DistSquared(Listener.Location, Location) <= FMath::Square(Reach))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void UNoiseEventSubsystem::RefreshGrid()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (LastGridRefreshTime >= 0.0 && Now - LastGridRefreshTime < GridRefreshInterval)
+	{
+		return;
+	}
+	LastGridRefreshTime = Now;
+
+	// Anything the hearing sense would deliver to: a possessed pawn whose controller's perception configures hearing
+	const FAISenseID HearingSenseID = UAISense::GetSenseID<UAISense_Hearing>();
+	Listeners.Reset();
+	MaxHearingRange = 0.f;
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AController* Controller = It->Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		UAIPerceptionComponent* Perception = Pawn ? Controller->FindComponentByClass<UAIPerceptionComponent>() : nullptr;
+		const UAISenseConfig_Hearing* HearingConfig = Perception ? Cast<UAISenseConfig_Hearing>(Perception->GetSenseConfig(HearingSenseID)) : nullptr;
+		if (!HearingConfig)
+		{
+			continue;
+		}
+
+		FListener& Listener = Listeners.AddDefaulted_GetRef();
+		Listener.Location = Pawn->GetActorLocation();
+		Listener.HearingRange = HearingConfig->HearingRange;
+		MaxHearingRange = FMath::Max(MaxHearingRange, Listener.HearingRange);
+	}
+
+	// One cell per hearing range keeps a query to the 3x3 neighbourhood for a normal-loudness event
+	CellSize = FMath::Max(MaxHearingRange, 100.f);
+
+	Grid.Reset();
+	for (int32 i = 0; i < Listeners.Num(); ++i)
+	{
+		Grid.FindOrAdd(GetCell(Listeners[i].Location)).Add(i);
+	}
+}
+
+FIntPoint UNoiseEventSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UNoiseEventSubsystem::Deinitialize()
+{
+	Channels.Empty();
+	Listeners.Empty();
+	Grid.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNoiseEventSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_NoiseEventsFlush);
+
+	if (Channels.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 i = Channels.Num() - 1; i >= 0; --i)
+	{
+		FNoiseChannel& Channel = Channels[i];
+		if (Now < Channel.WindowEnd)
+		{
+			continue;
+		}
+
+		if (Channel.bPending)
+		{
+			// The merged event opens the next window, so sustained fire stays at one event per window
+			Channel.bPending = false;
+			Channel.WindowEnd = Now + NoiseWindow;
+			EmitNoise(Channel.Instigator.Get(), Channel.Location, Channel.Loudness, Channel.MaxRange, Channel.Tag);
+		}
+		else
+		{
+			Channels.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+TStatId UNoiseEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNoiseEventSubsystem, STATGROUP_Tickables);
+}
+
+bool UNoiseEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
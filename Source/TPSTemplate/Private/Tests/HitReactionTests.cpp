@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Subsystems/HitReactionSubsystem.h"
+#include "Components/Hurtbox.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitReactionMergeTest, "TPSTemplate.HitReaction.Budget.Merge",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHitReactionMergeTest::RunTest(const FString& Parameters)
+{
+	UHurtbox* Hurtbox = NewObject<UHurtbox>();
+	UHurtbox* OtherHurtbox = NewObject<UHurtbox>();
+	const FName Spine(TEXT("spine_01"));
+	const FName Head(TEXT("head"));
+
+	FHitReactionBudget Budget;
+	Budget.Add(Hurtbox, Spine, 0.0, 0.5f);
+
+	TestFalse(TEXT("Other bone does not merge"), Budget.Merge(Hurtbox, Head, 0.1, 0.5f, 1.0f));
+	TestFalse(TEXT("Other hurtbox does not merge"), Budget.Merge(OtherHurtbox, Spine, 0.1, 0.5f, 1.0f));
+
+	// A later hit extends the reaction to Duration from now
+	TestTrue(TEXT("Same bone merges"), Budget.Merge(Hurtbox, Spine, 0.3, 0.5f, 1.0f));
+	TestEqual(TEXT("Merged reaction is extended"), Budget.Reactions[0].ExpireTime, 0.8);
+
+	// A short hit never shortens a running reaction
+	Budget.Merge(Hurtbox, Spine, 0.4, 0.1f, 1.0f);
+	TestEqual(TEXT("Shorter hit keeps the expiry"), Budget.Reactions[0].ExpireTime, 0.8);
+
+	// Repeated hits cannot keep a bone simulating past MaxDuration after it started
+	Budget.Merge(Hurtbox, Spine, 0.9, 0.5f, 1.0f);
+	TestEqual(TEXT("Expiry is capped at MaxDuration"), Budget.Reactions[0].ExpireTime, 1.0);
+	TestEqual(TEXT("Merging adds no body"), Budget.Reactions.Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitReactionEvictionTest, "TPSTemplate.HitReaction.Budget.Eviction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHitReactionEvictionTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxBodies = 3;
+	UHurtbox* Hurtbox = NewObject<UHurtbox>();
+
+	FHitReactionBudget Budget;
+	TestEqual(TEXT("Empty budget evicts nothing"), Budget.FindEviction(MaxBodies), INDEX_NONE);
+
+	Budget.Add(Hurtbox, TEXT("spine_01"), 0.0, 0.6f);
+	Budget.Add(Hurtbox, TEXT("head"), 0.0, 0.2f);
+	TestEqual(TEXT("Under budget evicts nothing"), Budget.FindEviction(MaxBodies), INDEX_NONE);
+
+	Budget.Add(Hurtbox, TEXT("upperarm_l"), 0.0, 0.4f);
+	TestEqual(TEXT("At budget evicts the reaction closest to recovering"), Budget.FindEviction(MaxBodies), 1);
+
+	// A lower budget (scalability change) keeps evicting until a new body fits
+	int32 Evicted = 0;
+	for (int32 Index = Budget.FindEviction(1); Index != INDEX_NONE; Index = Budget.FindEviction(1))
+	{
+		Budget.Reactions.RemoveAtSwap(Index);
+		++Evicted;
+	}
+	TestEqual(TEXT("Every body evicted for a budget of one"), Evicted, 3);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Data/InventoryGrid.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** The per-cell GUID grid FInventoryOccupancyGrid replaced, kept to check results and compare speed */
+	struct FLegacyGuidGrid
+	{
+		TArray<FGuid> Cells;
+		int32 Rows = 0;
+		int32 Cols = 0;
+
+		void Init(int32 InRows, int32 InCols)
+		{
+			Rows = InRows;
+			Cols = InCols;
+			Cells.Init(FGuid(), Rows * Cols);
+		}
+
+		void Mark(int32 Row, int32 Col, int32 Width, int32 Height, const FGuid& Id)
+		{
+			for (int32 r = Row; r < Row + Height; ++r)
+			{
+				for (int32 c = Col; c < Col + Width; ++c)
+				{
+					Cells[r * Cols + c] = Id;
+				}
+			}
+		}
+
+		bool CanPlace(int32 Row, int32 Col, int32 Width, int32 Height) const
+		{
+			if (Row < 0 || Col < 0 || Row + Height > Rows || Col + Width > Cols)
+			{
+				return false;
+			}
+
+			for (int32 r = Row; r < Row + Height; ++r)
+			{
+				for (int32 c = Col; c < Col + Width; ++c)
+				{
+					if (Cells[r * Cols + c].IsValid())
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		bool FindEmptySpot(int32 Width, int32 Height, int32& OutRow, int32& OutCol) const
+		{
+			for (int32 Row = 0; Row <= Rows - Height; ++Row)
+			{
+				for (int32 Col = 0; Col <= Cols - Width; ++Col)
+				{
+					if (CanPlace(Row, Col, Width, Height))
+					{
+						OutRow = Row;
+						OutCol = Col;
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+	};
+
+	/** Item footprints a loot burst is made of */
+	const FIntPoint QuerySizes[] = { { 1, 1 }, { 2, 1 }, { 2, 2 }, { 1, 3 }, { 3, 2 }, { 2, 4 }, { 4, 4 } };
+
+	/** Fill both grids with the same random rectangles until roughly FillRatio of the cells are taken */
+	void FillGrids(FInventoryOccupancyGrid& Grid, FLegacyGuidGrid& Legacy, int32 Rows, int32 Cols, float FillRatio, int32 Seed)
+	{
+		Grid.Init(Rows, Cols);
+		Legacy.Init(Rows, Cols);
+
+		FRandomStream Random(Seed);
+		const int32 TargetCells = FMath::RoundToInt(Rows * Cols * FillRatio);
+		for (int32 Attempt = 0; Attempt < Rows * Cols * 4 && Grid.GetOccupiedCount() < TargetCells; ++Attempt)
+		{
+			const int32 Width = Random.RandRange(1, 3);
+			const int32 Height = Random.RandRange(1, 3);
+			const int32 Row = Random.RandRange(0, Rows - Height);
+			const int32 Col = Random.RandRange(0, Cols - Width);
+			if (Grid.IsFree(Row, Col, Width, Height))
+			{
+				Grid.Mark(Row, Col, Width, Height);
+				Legacy.Mark(Row, Col, Width, Height, FGuid::NewGuid());
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryGridFirstFitTest, "TPSTemplate.Inventory.Grid.FirstFitMatchesCellScan",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryGridFirstFitTest::RunTest(const FString& Parameters)
+{
+	const FIntPoint GridSizes[] = { { 6, 6 }, { 20, 30 }, { 40, 64 } };
+	const float FillRatios[] = { 0.0f, 0.4f, 0.8f };
+
+	for (const FIntPoint& GridSize : GridSizes)
+	{
+		for (const float FillRatio : FillRatios)
+		{
+			FInventoryOccupancyGrid Grid;
+			FLegacyGuidGrid Legacy;
+			FillGrids(Grid, Legacy, GridSize.X, GridSize.Y, FillRatio, GridSize.X * 131 + GridSize.Y);
+
+			for (const FIntPoint& Size : QuerySizes)
+			{
+				int32 Row = INDEX_NONE, Col = INDEX_NONE;
+				int32 LegacyRow = INDEX_NONE, LegacyCol = INDEX_NONE;
+				const bool bFound = Grid.FindFirstFit(Size.X, Size.Y, Row, Col);
+				const bool bLegacyFound = Legacy.FindEmptySpot(Size.X, Size.Y, LegacyRow, LegacyCol);
+
+				const FString What = FString::Printf(TEXT("%dx%d item in %dx%d grid at %.0f%% fill"), Size.X, Size.Y, GridSize.X, GridSize.Y, FillRatio * 100.0f);
+				TestEqual(What + TEXT(" found"), bFound, bLegacyFound);
+				if (bFound && bLegacyFound)
+				{
+					TestEqual(What + TEXT(" row"), Row, LegacyRow);
+					TestEqual(What + TEXT(" column"), Col, LegacyCol);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryGridFitBenchmark, "TPSTemplate.Inventory.Grid.FitSearchBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryGridFitBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumPasses = 200;
+	const FIntPoint GridSizes[] = { { 20, 30 }, { 40, 64 } };
+
+	for (const FIntPoint& GridSize : GridSizes)
+	{
+		FInventoryOccupancyGrid Grid;
+		FLegacyGuidGrid Legacy;
+		FillGrids(Grid, Legacy, GridSize.X, GridSize.Y, 0.7f, 7);
+
+		// The found positions are summed so neither loop can be optimized away
+		int32 Checksum = 0;
+		int32 LegacyChecksum = 0;
+		int32 Row = 0, Col = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (const FIntPoint& Size : QuerySizes)
+			{
+				Checksum += Grid.FindFirstFit(Size.X, Size.Y, Row, Col) ? Row * GridSize.Y + Col : -1;
+			}
+		}
+		const double BitmaskTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (const FIntPoint& Size : QuerySizes)
+			{
+				LegacyChecksum += Legacy.FindEmptySpot(Size.X, Size.Y, Row, Col) ? Row * GridSize.Y + Col : -1;
+			}
+		}
+		const double LegacyTime = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(FString::Printf(TEXT("%dx%d results match"), GridSize.X, GridSize.Y), Checksum, LegacyChecksum);
+
+		const int32 NumSearches = NumPasses * UE_ARRAY_COUNT(QuerySizes);
+		AddInfo(FString::Printf(TEXT("%dx%d grid, 70%% full: bitmask %.3f us/search, GUID cell scan %.3f us/search (%.1fx)"),
+			GridSize.X, GridSize.Y,
+			BitmaskTime * 1e6 / NumSearches,
+			LegacyTime * 1e6 / NumSearches,
+			BitmaskTime > 0.0 ? LegacyTime / BitmaskTime : 0.0));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
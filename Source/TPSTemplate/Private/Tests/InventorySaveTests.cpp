@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Data/InventorySaveData.h"
+#include "Data/InventoryTypes.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySaveBenchmark, "TPSTemplate.Inventory.Save.BinaryVsSaveGameBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventorySaveBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSlots = 5000;
+	constexpr int32 NumAssets = 50;
+	constexpr int32 NumPasses = 10;
+
+	// The same stash in both formats: slots spread over a handful of item assets, as a large stash is
+	FInventorySaveData SaveData;
+	FInventoryItemArray ItemList;
+	for (int32 AssetIndex = 0; AssetIndex < NumAssets; ++AssetIndex)
+	{
+		SaveData.Assets.Add(FPrimaryAssetId(TEXT("WeaponData"), *FString::Printf(TEXT("DA_Item_%d"), AssetIndex)));
+	}
+
+	FRandomStream Random(3);
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		const int32 AssetIndex = Random.RandRange(0, NumAssets - 1);
+
+		FInventorySaveData::FSlotRecord& Record = SaveData.Slots.AddDefaulted_GetRef();
+		Record.AssetIndex = AssetIndex;
+		Record.GridRow = SlotIndex / 64;
+		Record.GridCol = SlotIndex % 64;
+		Record.Quantity = Random.RandRange(1, 30);
+		Record.Durability = Random.FRand();
+
+		FItemSlot& Slot = ItemList.Items.AddDefaulted_GetRef();
+		Slot.ItemData = TSoftObjectPtr<UItemData>(FSoftObjectPath(FString::Printf(TEXT("/Game/Items/DA_Item_%d.DA_Item_%d"), AssetIndex, AssetIndex)));
+		Slot.GridRow = Record.GridRow;
+		Slot.GridCol = Record.GridCol;
+		Slot.Quantity = Record.Quantity;
+		Slot.Durability = Record.Durability;
+	}
+
+	// FInventorySaveData: packed binary archive
+	TArray<uint8> BinaryBytes;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		SaveData.SaveToBytes(BinaryBytes);
+	}
+	const double BinarySaveTime = (FPlatformTime::Seconds() - StartTime) / NumPasses;
+
+	FInventorySaveData Loaded;
+	bool bBinaryLoaded = true;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		bBinaryLoaded &= Loaded.LoadFromBytes(BinaryBytes);
+	}
+	const double BinaryLoadTime = (FPlatformTime::Seconds() - StartTime) / NumPasses;
+
+	TestTrue(TEXT("Binary snapshot loads"), bBinaryLoaded);
+	TestEqual(TEXT("Binary snapshot keeps every slot"), Loaded.Slots.Num(), NumSlots);
+
+	// Naive USaveGame: tagged property serialization of the slot array, as UGameplayStatics::SaveGameToMemory does
+	TArray<uint8> TaggedBytes;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		TaggedBytes.Reset();
+		FMemoryWriter MemoryWriter(TaggedBytes, true);
+		FObjectAndNameAsStringProxyArchive Writer(MemoryWriter, false);
+		FInventoryItemArray::StaticStruct()->SerializeItem(Writer, &ItemList, nullptr);
+	}
+	const double TaggedSaveTime = (FPlatformTime::Seconds() - StartTime) / NumPasses;
+
+	FInventoryItemArray TaggedLoaded;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		TaggedLoaded.Items.Reset();
+		FMemoryReader MemoryReader(TaggedBytes, true);
+		FObjectAndNameAsStringProxyArchive Reader(MemoryReader, true);
+		FInventoryItemArray::StaticStruct()->SerializeItem(Reader, &TaggedLoaded, nullptr);
+	}
+	const double TaggedLoadTime = (FPlatformTime::Seconds() - StartTime) / NumPasses;
+
+	TestEqual(TEXT("Tagged snapshot keeps every slot"), TaggedLoaded.Items.Num(), NumSlots);
+
+	AddInfo(FString::Printf(TEXT("%d slots, FInventorySaveData: %d bytes, save %.3f ms, load %.3f ms"),
+		NumSlots, BinaryBytes.Num(), BinarySaveTime * 1000.0, BinaryLoadTime * 1000.0));
+	AddInfo(FString::Printf(TEXT("%d slots, reflected USaveGame properties: %d bytes, save %.3f ms, load %.3f ms (%.1fx the size)"),
+		NumSlots, TaggedBytes.Num(), TaggedSaveTime * 1000.0, TaggedLoadTime * 1000.0,
+		BinaryBytes.Num() > 0 ? static_cast<double>(TaggedBytes.Num()) / BinaryBytes.Num() : 0.0));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
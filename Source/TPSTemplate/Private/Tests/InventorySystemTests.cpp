@@ -0,0 +1,364 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Components/InventorySystem.h"
+#include "Data/ItemData.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Set a protected config property by name (grid size and weight limit are editor-only config) */
+	template <typename PropertyType, typename ValueType>
+	void SetConfigProperty(UInventorySystem* Inventory, FName PropertyName, ValueType Value)
+	{
+		if (PropertyType* Property = FindFProperty<PropertyType>(UInventorySystem::StaticClass(), PropertyName))
+		{
+			Property->SetPropertyValue_InContainer(Inventory, Value);
+		}
+	}
+
+	UInventorySystem* CreateInventory(int32 Rows, int32 Cols)
+	{
+		UInventorySystem* Inventory = NewObject<UInventorySystem>();
+		SetConfigProperty<FIntProperty>(Inventory, TEXT("RowCapacity"), Rows);
+		SetConfigProperty<FIntProperty>(Inventory, TEXT("ColCapacity"), Cols);
+		SetConfigProperty<FFloatProperty>(Inventory, TEXT("MaxWeight"), MAX_flt);
+		Inventory->InitializeGrid();
+		return Inventory;
+	}
+
+	UItemData* CreateItemData(int32 Width, int32 Height)
+	{
+		UItemData* ItemData = NewObject<UItemData>();
+		ItemData->GridWidth = Width;
+		ItemData->GridHeight = Height;
+		ItemData->bStackable = false;
+		ItemData->MaxStackSize = 1;
+		ItemData->Weight = 0.f;
+		return ItemData;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySystemStressTest, "TPSTemplate.Inventory.System.ThousandsOfItems",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FInventorySystemStressTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Rows = 64;
+	constexpr int32 Cols = 64;
+
+	UInventorySystem* Inventory = CreateInventory(Rows, Cols);
+	UItemData* ItemData = CreateItemData(1, 1);
+
+	// Fill every cell, remembering which item went where
+	TArray<FGuid> CellIds;
+	CellIds.Reserve(Rows * Cols);
+	for (int32 Row = 0; Row < Rows; ++Row)
+	{
+		for (int32 Col = 0; Col < Cols; ++Col)
+		{
+			if (!Inventory->AddItem(ItemData, Row, Col))
+			{
+				AddError(FString::Printf(TEXT("AddItem failed at (%d, %d)"), Row, Col));
+				return false;
+			}
+			CellIds.Add(Inventory->GetItems().Last().InstanceId);
+		}
+	}
+	TestEqual(TEXT("Item count after fill"), Inventory->GetItems().Num(), Rows * Cols);
+
+	// Once when the grid is full, once when the refill below runs out of room
+	AddExpectedError(TEXT("Can't find Empty Spot"), EAutomationExpectedErrorFlags::Contains, 2);
+	TestFalse(TEXT("Full grid has no free 1x1 spot"), Inventory->TryAddItemEmptySpot(ItemData));
+
+	// Remove every third item; each removal swap-moves the last item into the hole
+	TSet<FGuid> RemovedIds;
+	for (int32 Cell = 0; Cell < CellIds.Num(); Cell += 3)
+	{
+		TestTrue(TEXT("RemoveItem"), Inventory->RemoveItem(CellIds[Cell]));
+		RemovedIds.Add(CellIds[Cell]);
+	}
+	TestEqual(TEXT("Item count after removal"), Inventory->GetItems().Num(), CellIds.Num() - RemovedIds.Num());
+
+	// Every lookup must still agree with where the item was placed
+	for (int32 Cell = 0; Cell < CellIds.Num(); ++Cell)
+	{
+		const int32 Row = Cell / Cols;
+		const int32 Col = Cell % Cols;
+		const FGuid& Id = CellIds[Cell];
+
+		FItemSlot CellItem;
+		const bool bCellOccupied = Inventory->GetItemAtCellCopy(Row, Col, CellItem);
+		const FItemSlot* FoundItem = Inventory->FindItem(Id);
+
+		if (RemovedIds.Contains(Id))
+		{
+			TestFalse(FString::Printf(TEXT("Removed item cell (%d, %d) is empty"), Row, Col), bCellOccupied);
+			TestNull(FString::Printf(TEXT("Removed item at (%d, %d) is not found"), Row, Col), FoundItem);
+		}
+		else if (!FoundItem || !bCellOccupied || FoundItem->InstanceId != Id || CellItem.InstanceId != Id
+			|| FoundItem->GridRow != Row || FoundItem->GridCol != Col)
+		{
+			AddError(FString::Printf(TEXT("Lookups disagree for the item placed at (%d, %d)"), Row, Col));
+		}
+	}
+
+	// Freed cells are reusable and the rest of the grid stays consistent
+	int32 Refilled = 0;
+	while (Inventory->TryAddItemEmptySpot(ItemData))
+	{
+		++Refilled;
+	}
+	TestEqual(TEXT("Every freed cell is refilled"), Refilled, RemovedIds.Num());
+	TestEqual(TEXT("Pack density after refill"), Inventory->GetPackDensity(), 1.f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySystemLookupBenchmark, "TPSTemplate.Inventory.System.LookupBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventorySystemLookupBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 Rows = 64;
+	constexpr int32 Cols = 64;
+	constexpr int32 NumPasses = 20;
+
+	UInventorySystem* Inventory = CreateInventory(Rows, Cols);
+	UItemData* ItemData = CreateItemData(1, 1);
+	for (int32 Cell = 0; Cell < Rows * Cols; ++Cell)
+	{
+		Inventory->AddItem(ItemData, Cell / Cols, Cell % Cols);
+	}
+
+	TArray<FGuid> Ids;
+	for (const FItemSlot& Item : Inventory->GetItems())
+	{
+		Ids.Add(Item.InstanceId);
+	}
+
+	// Look items up in a shuffled order so the id map is not walked in insertion order
+	FRandomStream Random(11);
+	for (int32 i = Ids.Num() - 1; i > 0; --i)
+	{
+		Ids.Swap(i, Random.RandRange(0, i));
+	}
+
+	int32 Found = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		for (const FGuid& Id : Ids)
+		{
+			Found += Inventory->FindItem(Id) ? 1 : 0;
+		}
+	}
+	const double FindTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 Occupied = 0;
+	FItemSlot CellItem;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		for (int32 Cell = 0; Cell < Rows * Cols; ++Cell)
+		{
+			Occupied += Inventory->GetItemAtCellCopy(Cell / Cols, Cell % Cols, CellItem) ? 1 : 0;
+		}
+	}
+	const double CellTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Every item found"), Found, Ids.Num() * NumPasses);
+	TestEqual(TEXT("Every cell occupied"), Occupied, Rows * Cols * NumPasses);
+
+	AddInfo(FString::Printf(TEXT("%d items: FindItem %.3f us, GetItemAtCellCopy %.3f us"),
+		Ids.Num(),
+		FindTime * 1e6 / (Ids.Num() * NumPasses),
+		CellTime * 1e6 / (Rows * Cols * NumPasses)));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryPlacementBenchmark, "TPSTemplate.Inventory.System.PlacementBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryPlacementBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumItems = 400;
+	const FIntPoint ContainerSizes[] = { { 8, 10 }, { 12, 16 }, { 20, 30 } };
+	const FIntPoint ItemSizes[] = { { 1, 1 }, { 1, 2 }, { 2, 1 }, { 2, 2 }, { 1, 3 }, { 3, 2 }, { 2, 4 } };
+
+	TArray<UItemData*> ItemDatas;
+	for (const FIntPoint& Size : ItemSizes)
+	{
+		ItemDatas.Add(CreateItemData(Size.X, Size.Y));
+	}
+
+	// Containers overflow on purpose: every strategy logs its no-room warnings
+	AddExpectedError(TEXT("Can't find Empty Spot"), EAutomationExpectedErrorFlags::Contains, 0);
+	AddExpectedError(TEXT("AutoArrange failed"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	for (const FIntPoint& ContainerSize : ContainerSizes)
+	{
+		// Both strategies get the same loot stream; the container is full once items stop fitting
+		TArray<UItemData*> Stream;
+		FRandomStream Random(ContainerSize.X * 31 + ContainerSize.Y);
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			Stream.Add(ItemDatas[Random.RandRange(0, ItemDatas.Num() - 1)]);
+		}
+
+		UInventorySystem* FirstFit = CreateInventory(ContainerSize.X, ContainerSize.Y);
+		int32 FirstFitPlaced = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (UItemData* ItemData : Stream)
+		{
+			FirstFitPlaced += FirstFit->TryAddItemEmptySpot(ItemData) ? 1 : 0;
+		}
+		const double FirstFitTime = FPlatformTime::Seconds() - StartTime;
+
+		UInventorySystem* BestFit = CreateInventory(ContainerSize.X, ContainerSize.Y);
+		int32 BestFitPlaced = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (UItemData* ItemData : Stream)
+		{
+			BestFitPlaced += BestFit->TryAddItemBestFit(ItemData) ? 1 : 0;
+		}
+		const double BestFitTime = FPlatformTime::Seconds() - StartTime;
+
+		UInventorySystem* Arranged = CreateInventory(ContainerSize.X, ContainerSize.Y);
+		for (UItemData* ItemData : Stream)
+		{
+			Arranged->TryAddItemEmptySpot(ItemData);
+		}
+		StartTime = FPlatformTime::Seconds();
+		const bool bArranged = Arranged->AutoArrange();
+		const double ArrangeTime = FPlatformTime::Seconds() - StartTime;
+		int32 ArrangedPlaced = Arranged->GetItems().Num();
+		for (UItemData* ItemData : Stream)
+		{
+			ArrangedPlaced += Arranged->TryAddItemBestFit(ItemData) ? 1 : 0;
+		}
+
+		AddInfo(FString::Printf(TEXT("%dx%d: first-fit %d items, %.1f%% full, %.2f us/insert | best-fit %d items, %.1f%% full, %.2f us/insert"),
+			ContainerSize.X, ContainerSize.Y,
+			FirstFitPlaced, FirstFit->GetPackDensity() * 100.f, FirstFitTime * 1e6 / NumItems,
+			BestFitPlaced, BestFit->GetPackDensity() * 100.f, BestFitTime * 1e6 / NumItems));
+		AddInfo(FString::Printf(TEXT("%dx%d: first-fit then AutoArrange (%s, %.2f ms) and best-fit top-up: %d items, %.1f%% full"),
+			ContainerSize.X, ContainerSize.Y,
+			bArranged ? TEXT("ok") : TEXT("failed"), ArrangeTime * 1e3,
+			ArrangedPlaced, Arranged->GetPackDensity() * 100.f));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryAddItemsRollbackTest, "TPSTemplate.Inventory.System.AddItemsRollback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryAddItemsRollbackTest::RunTest(const FString& Parameters)
+{
+	UItemData* Small = CreateItemData(1, 1);
+	UItemData* Large = CreateItemData(2, 2);
+	UItemData* Ammo = CreateItemData(1, 1);
+	Ammo->bStackable = true;
+	Ammo->MaxStackSize = 5;
+
+	// Five 1x1 items into four cells: the last one has no room
+	const TArray<FItemAddRequest> Overfull = { { Small }, { Small }, { Small }, { Small }, { Small } };
+
+	AddExpectedError(TEXT("nothing committed"), EAutomationExpectedErrorFlags::Contains, 1);
+	UInventorySystem* AllOrNothing = CreateInventory(2, 2);
+	const FItemAddBatchResult Rejected = AllOrNothing->AddItems(Overfull, true);
+	TestFalse(TEXT("All-or-nothing batch is not committed"), Rejected.bCommitted);
+	TestEqual(TEXT("All-or-nothing batch adds nothing"), Rejected.NumAdded, 0);
+	TestTrue(TEXT("All-or-nothing batch reports the failed request"), Rejected.FailedRequests == TArray<int32>{ 4 });
+	TestEqual(TEXT("All-or-nothing batch leaves no slots"), AllOrNothing->GetItems().Num(), 0);
+	TestEqual(TEXT("All-or-nothing batch leaves the grid empty"), AllOrNothing->GetPackDensity(), 0.f);
+
+	UInventorySystem* Partial = CreateInventory(2, 2);
+	const FItemAddBatchResult Accepted = Partial->AddItems(Overfull, false);
+	TestTrue(TEXT("Partial batch is committed"), Accepted.bCommitted);
+	TestEqual(TEXT("Partial batch adds what fits"), Accepted.NumAdded, 4);
+	TestTrue(TEXT("Partial batch reports the failed request"), Accepted.FailedRequests == TArray<int32>{ 4 });
+	TestEqual(TEXT("Partial batch places four slots"), Partial->GetItems().Num(), 4);
+
+	// Failures anywhere in the batch are reported by request index
+	UInventorySystem* Mixed = CreateInventory(2, 2);
+	const TArray<FItemAddRequest> MixedRequests = { { Small }, { nullptr }, { Large }, { Small, 0 }, { Small } };
+	const FItemAddBatchResult MixedResult = Mixed->AddItems(MixedRequests, false);
+	TestTrue(TEXT("Invalid, oversized and empty requests are reported"), MixedResult.FailedRequests == TArray<int32>{ 1, 2, 3 });
+	TestEqual(TEXT("Valid requests around them are added"), MixedResult.NumAdded, 2);
+
+	// A rejected batch does not leave stack merges behind
+	AddExpectedError(TEXT("nothing committed"), EAutomationExpectedErrorFlags::Contains, 1);
+	UInventorySystem* Stacks = CreateInventory(1, 2);
+	Stacks->AddItem(Ammo, 0, 0, 3);
+	const TArray<FItemAddRequest> StackThenOverflow = { { Ammo, 2 }, { Large } };
+	Stacks->AddItems(StackThenOverflow, true);
+	TestEqual(TEXT("Rejected batch leaves the existing stack unchanged"), Stacks->GetItems()[0].Quantity, 3);
+	TestEqual(TEXT("Rejected batch adds no slot"), Stacks->GetItems().Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryAddItemsBenchmark, "TPSTemplate.Inventory.System.AddItemsBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryAddItemsBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumPasses = 20;
+	const int32 BatchSizes[] = { 8, 32, 128 };
+	const FIntPoint ItemSizes[] = { { 1, 1 }, { 1, 2 }, { 2, 1 }, { 2, 2 } };
+
+	TArray<UItemData*> ItemDatas;
+	for (const FIntPoint& Size : ItemSizes)
+	{
+		ItemDatas.Add(CreateItemData(Size.X, Size.Y));
+	}
+	UItemData* Ammo = CreateItemData(1, 1);
+	Ammo->bStackable = true;
+	Ammo->MaxStackSize = 50;
+	ItemDatas.Add(Ammo);
+
+	for (const int32 BatchSize : BatchSizes)
+	{
+		// A loot drop: mixed sizes plus stackable ammo, sized to fit the container
+		TArray<FItemAddRequest> Batch;
+		FRandomStream Random(BatchSize);
+		for (int32 i = 0; i < BatchSize; ++i)
+		{
+			UItemData* ItemData = ItemDatas[Random.RandRange(0, ItemDatas.Num() - 1)];
+			Batch.Emplace(ItemData, ItemData == Ammo ? Random.RandRange(1, 20) : 1);
+		}
+
+		double BatchTime = 0.0;
+		double PerItemTime = 0.0;
+		int32 BatchSlots = 0;
+		int32 PerItemSlots = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			UInventorySystem* Batched = CreateInventory(40, 64);
+			double StartTime = FPlatformTime::Seconds();
+			Batched->AddItems(Batch);
+			BatchTime += FPlatformTime::Seconds() - StartTime;
+			BatchSlots = Batched->GetItems().Num();
+
+			UInventorySystem* PerItem = CreateInventory(40, 64);
+			StartTime = FPlatformTime::Seconds();
+			for (const FItemAddRequest& Request : Batch)
+			{
+				PerItem->TryAddItemEmptySpot(Request.ItemData, Request.Quantity);
+			}
+			PerItemTime += FPlatformTime::Seconds() - StartTime;
+			PerItemSlots = PerItem->GetItems().Num();
+		}
+
+		TestEqual(FString::Printf(TEXT("%d-item batch places the same slots as the per-item path"), BatchSize), BatchSlots, PerItemSlots);
+
+		AddInfo(FString::Printf(TEXT("%d items: AddItems %.2f us/batch (1 broadcast), TryAddItemEmptySpot loop %.2f us/batch (%d broadcasts), %.1fx"),
+			BatchSize,
+			BatchTime * 1e6 / NumPasses,
+			PerItemTime * 1e6 / NumPasses, BatchSize,
+			BatchTime > 0.0 ? PerItemTime / BatchTime : 0.0));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
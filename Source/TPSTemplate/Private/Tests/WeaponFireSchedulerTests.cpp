@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Weapon/WeaponFireScheduler.h"
+#include "Data/WeaponData.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Hold the trigger for Seconds at a fixed frame rate and count the shots released */
+	int32 SimulateHeldTrigger(FWeaponFireScheduler& Scheduler, float FrameRate, float Seconds)
+	{
+		const float DeltaTime = 1.0f / FrameRate;
+		const int32 NumFrames = FMath::RoundToInt(Seconds * FrameRate);
+
+		int32 Shots = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Shots += Scheduler.Advance(DeltaTime, true);
+		}
+		return Shots;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponFireSchedulerFrameRateTest, "TPSTemplate.Weapon.FireScheduler.FrameRateIndependent",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponFireSchedulerFrameRateTest::RunTest(const FString& Parameters)
+{
+	// 600 RPM for 10 seconds: 100 shots, plus the one released on the first frame of the press
+	constexpr float ShotInterval = 0.1f;
+	constexpr float HoldSeconds = 10.0f;
+	const int32 Expected = FMath::RoundToInt(HoldSeconds / ShotInterval) + 1;
+
+	const float FrameRates[] = { 30.0f, 60.0f, 144.0f };
+	for (const float FrameRate : FrameRates)
+	{
+		FWeaponFireScheduler Scheduler;
+		Scheduler.SetShotInterval(ShotInterval);
+
+		const int32 Shots = SimulateHeldTrigger(Scheduler, FrameRate, HoldSeconds);
+		TestTrue(FString::Printf(TEXT("%.0f fps fires %d shots (expected %d)"), FrameRate, Shots, Expected),
+			FMath::Abs(Shots - Expected) <= 1);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponFireSchedulerPressLimitTest, "TPSTemplate.Weapon.FireScheduler.ShotsPerPress",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponFireSchedulerPressLimitTest::RunTest(const FString& Parameters)
+{
+	const float FrameRates[] = { 30.0f, 60.0f, 144.0f };
+	for (const float FrameRate : FrameRates)
+	{
+		// Semi-auto: one shot however long the trigger is held
+		FWeaponFireScheduler SemiAuto;
+		SemiAuto.SetShotInterval(0.1f);
+		SemiAuto.SetShotsPerPress(1);
+		TestEqual(FString::Printf(TEXT("Semi-auto at %.0f fps"), FrameRate), SimulateHeldTrigger(SemiAuto, FrameRate, 2.0f), 1);
+
+		// Burst: the burst size, then nothing until release
+		FWeaponFireScheduler Burst;
+		Burst.SetShotInterval(0.05f);
+		Burst.SetShotsPerPress(3);
+		TestEqual(FString::Printf(TEXT("Burst at %.0f fps"), FrameRate), SimulateHeldTrigger(Burst, FrameRate, 2.0f), 3);
+
+		// Releasing starts a new press once the cooldown has run out
+		Burst.Advance(1.0f / FrameRate, false);
+		Burst.Advance(1.0f, false);
+		TestEqual(FString::Printf(TEXT("Burst second press at %.0f fps"), FrameRate), SimulateHeldTrigger(Burst, FrameRate, 2.0f), 3);
+	}
+
+	// Blocking fire mid-press does not end the press, so semi-auto does not refire when it clears
+	FWeaponFireScheduler Blocked;
+	Blocked.SetShotInterval(0.1f);
+	Blocked.SetShotsPerPress(1);
+	int32 Shots = Blocked.Advance(0.016f, true);
+	Shots += Blocked.Advance(0.5f, true, false);
+	Shots += Blocked.Advance(0.5f, true);
+	TestEqual(TEXT("Semi-auto blocked mid-press"), Shots, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponFireSchedulerFireModeTest, "TPSTemplate.Weapon.FireScheduler.FireModeShotsPerPress",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponFireSchedulerFireModeTest::RunTest(const FString& Parameters)
+{
+	// A burst shotgun: BurstAmount is pellets per shot and must not change how many shots a press fires
+	UWeaponData* WeaponData = NewObject<UWeaponData>();
+	WeaponData->FireRate = 0.05f;
+	WeaponData->BurstAmount = 8;
+	WeaponData->BurstShotCount = 3;
+
+	const TPair<EFireMode, int32> Cases[] = {
+		{ EFireMode::SemiAuto, 1 },
+		{ EFireMode::Burst, 3 },
+		{ EFireMode::FullAuto, FMath::RoundToInt(2.0f / 0.05f) + 1 }
+	};
+
+	for (const TPair<EFireMode, int32>& Case : Cases)
+	{
+		WeaponData->FireMode = Case.Key;
+
+		FWeaponFireScheduler Scheduler;
+		Scheduler.SetShotInterval(WeaponData->FireRate);
+		Scheduler.SetShotsPerPress(WeaponData->GetShotsPerPress());
+
+		const int32 Shots = SimulateHeldTrigger(Scheduler, 60.0f, 2.0f);
+		TestTrue(FString::Printf(TEXT("Fire mode %d fires %d shots per 2 s press (expected %d)"), static_cast<int32>(Case.Key), Shots, Case.Value),
+			FMath::Abs(Shots - Case.Value) <= (Case.Key == EFireMode::FullAuto ? 1 : 0));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
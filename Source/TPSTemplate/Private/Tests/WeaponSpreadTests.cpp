@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Weapon/WeaponSpread.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponSpreadSeedTest, "TPSTemplate.Weapon.Spread.SameSeedSameSequence",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponSpreadSeedTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSamples = 1000;
+
+	FWeaponSpreadGenerator First, Second, Other;
+	First.Initialize(1234);
+	Second.Initialize(1234);
+	Other.Initialize(4321);
+
+	bool bSame = true;
+	bool bDiffers = false;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const FVector2D Sample = First.SampleDisk(2.0f);
+		bSame &= Sample == Second.SampleDisk(2.0f);
+		bDiffers |= Sample != Other.SampleDisk(2.0f);
+	}
+	TestTrue(TEXT("Same seed gives the same sequence"), bSame);
+	TestTrue(TEXT("Different seed gives a different sequence"), bDiffers);
+
+	// Re-initializing restarts the sequence
+	First.Initialize(1234);
+	Second.Initialize(1234);
+	First.SampleDisk(1.0f);
+	First.Initialize(1234);
+	TestTrue(TEXT("Initialize restarts the sequence"), First.SampleDisk(1.0f) == Second.SampleDisk(1.0f));
+	TestEqual(TEXT("Seed is kept"), First.GetSeed(), 1234);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponSpreadDistributionTest, "TPSTemplate.Weapon.Spread.UniformOverDisk",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponSpreadDistributionTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSamples = 20000;
+	constexpr int32 NumRings = 4;
+	constexpr float Radius = 3.0f;
+
+	FWeaponSpreadGenerator Spread;
+	Spread.Initialize(77);
+
+	// Rings of equal area: r^2 in [k/N, (k+1)/N) each hold 1/N of a uniform disk
+	int32 RingCounts[NumRings] = {};
+	int32 Outside = 0;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const FVector2D Sample = Spread.SampleDisk(Radius) / Radius;
+		const double DistanceSquared = Sample.SizeSquared();
+		if (DistanceSquared > 1.0 + KINDA_SMALL_NUMBER)
+		{
+			++Outside;
+			continue;
+		}
+		++RingCounts[FMath::Min(static_cast<int32>(DistanceSquared * NumRings), NumRings - 1)];
+	}
+
+	TestEqual(TEXT("Samples outside the disk"), Outside, 0);
+
+	// The table is stratified by ring, so only the draw order adds noise
+	for (int32 Ring = 0; Ring < NumRings; ++Ring)
+	{
+		const float Fraction = static_cast<float>(RingCounts[Ring]) / NumSamples;
+		TestTrue(FString::Printf(TEXT("Equal-area ring %d holds %.3f of the samples (expected ~%.3f)"), Ring, Fraction, 1.0f / NumRings),
+			FMath::IsNearlyEqual(Fraction, 1.0f / NumRings, 0.02f));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
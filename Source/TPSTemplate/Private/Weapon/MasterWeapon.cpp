@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Weapon/MasterWeapon.h"
+#include "TPSTemplate.h"
 #include "Components/WeaponSystem.h"
 #include "Components/HealthSystem.h"
 #include "Characters/TPSTemplateCharacter.h"
@@ -17,6 +18,41 @@
 #include "Widget/W_DynamicWeaponHUD.h"
 #include "Interfaces/Damageable.h"
 #include "Engine/DamageEvents.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "Subsystems/HitscanSubsystem.h"
+#include "Subsystems/BallisticsSubsystem.h"
+#include "Subsystems/DamageAggregatorSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Fire"), STAT_WeaponFire, STATGROUP_TPSTemplate);
+
+namespace
+{
+    /** Used when neither the weapon nor the tracer class says how long a tracer lives */
+    constexpr float DefaultTracerLifetime = 2.0f;
+
+    /** Weapon mesh socket bullets and effects come from */
+    const FName MuzzleSocketName(TEXT("Muzzle"));
+
+    FAutoConsoleCommandWithWorldAndArgs FireBenchmarkCommand(
+        TEXT("tps.Weapon.FireBenchmark"),
+        TEXT("tps.Weapon.FireBenchmark [Shots=1000]: time the per-shot hot path of the local player's weapon, old LogTemp logging vs LogTPSWeapon (no shots are fired)."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+            const APlayer_Base* Player = PC ? Cast<APlayer_Base>(PC->GetPawn()) : nullptr;
+            AMasterWeapon* Weapon = Player ? Player->GetEquippedWeapon() : nullptr;
+            if (!Weapon)
+            {
+                UE_LOG(LogTPSWeapon, Warning, TEXT("[Fire] tps.Weapon.FireBenchmark needs a local player with a weapon equipped"));
+                return;
+            }
+
+            Weapon->RunFireBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000);
+        }),
+        ECVF_Cheat
+    );
+}
 
 // Sets default values
 AMasterWeapon::AMasterWeapon()
@@ -36,6 +72,7 @@ AMasterWeapon::AMasterWeapon()
     WeaponType = EAnimationState::Unarmed;
     bReloading = false;
     bAutoReload = false;
+    Muzzle = nullptr;
 
     WeaponSystem->bIsDryAmmo = false;
 
@@ -62,232 +99,274 @@ void AMasterWeapon::BeginPlay()
         WeaponSystem->Weapon_Details.Weapon_Data.Ammo_Count = WeaponData->AmmoCount;
         WeaponSystem->Weapon_Details.Weapon_Data.ShortGun_Trace = WeaponData->bShortGunTrace;
 
-        UE_LOG(LogTemp, Log, TEXT("MasterWeapon::BeginPlay - Loaded ammo from WeaponData: CurrentAmmo=%d, MaxAmmo=%d"),
+        UE_LOG(LogTPSWeapon, Log, TEXT("MasterWeapon::BeginPlay - Loaded ammo from WeaponData: CurrentAmmo=%d, MaxAmmo=%d"),
             WeaponData->CurrentAmmo, WeaponData->MaxAmmo);
+
+        // Unset seeds come from the asset path, so server, clients and replays all start the same sequence
+        Spread.Initialize(WeaponData->SpreadSeed != 0 ? WeaponData->SpreadSeed : static_cast<int32>(GetTypeHash(WeaponData->GetPathName())));
+
+        // Tracers come from the world pool, so the first burst does not pay for SpawnActor
+        UActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UActorPoolSubsystem>();
+        if (ActorPool && WeaponData->BulletTraceClass)
+        {
+            ActorPool->Prewarm(WeaponData->BulletTraceClass, WeaponData->TracerPrewarmCount);
+        }
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::BeginPlay - WeaponData is not assigned! Using default ammo values."));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::BeginPlay - WeaponData is not assigned! Using default ammo values."));
     }
 }
 
-void AMasterWeapon::FireBullet(FHitResult Hit, bool bReturnHit)
+void AMasterWeapon::OnAimTraceComplete(const FHitResult& AimHit)
+{
+    // Aim traces resolve in the order they were queued, so the oldest context belongs to this one
+    if (PendingFireContexts.Num() == 0)
+    {
+        return;
+    }
+    const FWeaponFireContext Context = MoveTemp(PendingFireContexts[0]);
+    PendingFireContexts.RemoveAt(0, 1, EAllowShrinking::No);
+
+    if (!WeaponData)
+    {
+        return;
+    }
+
+    if (AimHit.bBlockingHit)
+    {
+        // Hit something - fire at target
+        FireBullet(Context, AimHit);
+    }
+    else if (WeaponData->BallisticsModel == EBallisticsModel::Projectile)
+    {
+        // Nothing within MaxRange - the projectile still flies, aimed at the end of the aim trace
+        FHitResult MissHit(Context.AimStart, Context.AimEnd);
+        MissHit.Location = Context.AimEnd;
+        FireBullet(Context, MissHit);
+    }
+    else
+    {
+        // Didn't hit anything - fire blank tracer
+        FireBlankTracer(Context);
+    }
+}
+
+void AMasterWeapon::FireBullet(const FWeaponFireContext& Context, const FHitResult& Hit)
 {
     // ===== 디버그 로그 추가 =====
-    UE_LOG(LogTemp, Warning, TEXT("[FireBullet] Hit.Location: %s, bBlockingHit: %d"),
+    UE_LOG(LogTPSWeapon, Verbose, TEXT("[FireBullet] Hit.Location: %s, bBlockingHit: %d"),
         *Hit.Location.ToString(), Hit.bBlockingHit);
     // ===========================
 
+    const FVector MuzzleLocation = Context.GetMuzzleLocation();
+
+    // ===== 디버그 로그 추가 =====
+    UE_LOG(LogTPSWeapon, Verbose, TEXT("[FireBullet] MuzzleLocation: %s"), *MuzzleLocation.ToString());
+    // ===========================
+
+    // Recoil shifts the whole shot, spread scatters each pellet around it
+    const float SpreadRadius = FMath::Tan(WeaponData->BulletSpread) * 10.0f;
+    const FVector2D Recoil = FWeaponSpreadGenerator::GetRecoilOffset(WeaponData->RecoilPattern, Context.ShotIndex);
+
+    // Every pellet of the burst is traced in one batch
+    TArray<FVector, TInlineAllocator<8>> PelletEnds;
+    PelletEnds.Reserve(WeaponData->BurstAmount);
     for (int32 curBurst = 0; curBurst < WeaponData->BurstAmount; curBurst++)
     {
-        float PointX, PointY;
-        RandPointInCircle(FMath::Tan(WeaponData->BulletSpread) * 10.0f, PointX, PointY);
+        const FVector2D Point = Recoil + Spread.SampleDisk(SpreadRadius);
 
-        // Get the player camera manager for the bullet direction
-        APlayerCameraManager* CameraManager = GetWorld()->GetFirstPlayerController()->PlayerCameraManager;
-        if (!CameraManager)
-        {
-            return;
-        }
-        FVector SpreadAdjustedHitLocation = Hit.Location + CameraManager->GetActorRightVector() * PointX + CameraManager->GetActorUpVector() * PointY;
-        FVector MuzzleLocation = WeaponMesh->GetSocketLocation(FName("Muzzle"));
+        FVector SpreadAdjustedHitLocation = Hit.Location + Context.ViewRight * Point.X + Context.ViewUp * Point.Y;
 
-        // ===== 디버그 로그 추가 =====
-        UE_LOG(LogTemp, Warning, TEXT("[FireBullet] MuzzleLocation: %s"), *MuzzleLocation.ToString());
-        UE_LOG(LogTemp, Warning, TEXT("[FireBullet] SpreadAdjustedHitLocation: %s"), *SpreadAdjustedHitLocation.ToString());
-        // ===========================
         // BulletDirection represents the direction from the muzzle to the target.
         // Calculate the direction vector of the trajectory 
         // by subtracting the aim point position from the muzzle position.
         FVector BulletDirection = MuzzleLocation - SpreadAdjustedHitLocation;
-        
-        // Setup trace parameters
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(this);
-        
-        // Create array of actors to ignore
-        if (!WeaponSystem)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("WeaponSystem is NULL"));
-            return;
-        }
-        else if (!WeaponSystem->CharacterRef)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("WeaponSystem->CharacterRef is NULL"));
-            return;
-        }
-        QueryParams.AddIgnoredActor(Cast<AActor>(WeaponSystem->CharacterRef));
-
-        // ===== 디버그 라인 활성화 =====
-        // DrawDebugLine(
-        //     GetWorld(),           // 월드
-        //     MuzzleLocation,        // 시작점
-        //     MuzzleLocation + (BulletDirection * -5.0f),          // 끝점
-        //     FColor::Yellow,       // 라인 색상
-        //     false,               // 지속적으로 그릴지 여부
-        //     5.0f,                // 지속 시간 (초)
-        //     0,                   // 우선순위
-        //     2.0f                 // 두께
-        // );
-        // ==============================
-        // Perform line trace
-        FHitResult HitResult;
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
-            HitResult,
-            MuzzleLocation,
-            MuzzleLocation + (BulletDirection * -5.0f),
-            COLLISION_BULLET,
-            QueryParams
-        );
-        if (!bHit)
+        PelletEnds.Add(MuzzleLocation + (BulletDirection * -5.0f));
+    }
+
+    // Simulated projectiles travel towards the same points instead of resolving instantly
+    if (WeaponData->BallisticsModel == EBallisticsModel::Projectile)
+    {
+        if (UBallisticsSubsystem* Ballistics = GetWorld()->GetSubsystem<UBallisticsSubsystem>())
         {
-            GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Anyone not Hit!!!!!!"));
+            for (const FVector& PelletEnd : PelletEnds)
+            {
+                Ballistics->FireProjectile(this, MuzzleLocation, PelletEnd - MuzzleLocation);
+            }
             return;
         }
+    }
+
+    if (UHitscanSubsystem* Hitscan = GetWorld()->GetSubsystem<UHitscanSubsystem>())
+    {
+        Hitscan->QueuePelletTraces(this, MuzzleLocation, PelletEnds, COLLISION_BULLET, Context.BulletQueryParams);
+        return;
+    }
 
-        // Process hit result
-        if (HitResult.GetActor())
+    // No async batching in this world - trace synchronously
+    TArray<FHitResult, TInlineAllocator<8>> PelletHits;
+    for (const FVector& PelletEnd : PelletEnds)
+    {
+        GetWorld()->LineTraceSingleByChannel(PelletHits.AddDefaulted_GetRef(), MuzzleLocation, PelletEnd, COLLISION_BULLET, Context.BulletQueryParams);
+    }
+    OnPelletTracesComplete(MuzzleLocation, PelletHits);
+}
+
+void AMasterWeapon::OnPelletTracesComplete(const FVector& MuzzleLocation, TConstArrayView<FHitResult> PelletHits)
+{
+    if (!WeaponData)
+    {
+        return;
+    }
+
+    for (const FHitResult& HitResult : PelletHits)
+    {
+        if (!HitResult.bBlockingHit)
         {
-            // Check if hit component is simulating physics
-            UPrimitiveComponent* HitComponent = HitResult.GetComponent();
-            if (HitComponent && HitComponent->IsSimulatingPhysics())
+            if (IsWeaponDebugEnabled() && GEngine)
             {
-                // Apply physics impulse at impact point
-                FVector ImpulseDir = -BulletDirection.GetSafeNormal();
-                HitComponent->AddImpulseAtLocation(ImpulseDir * -1000.0f, HitResult.Location);
+                GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Anyone not Hit!!!!!!"));
             }
+            continue;
+        }
 
-            // Apply damage to hit actor
-            bool bValidHit;
-            bool bKilledPlayer = ApplyHit(HitResult, bValidHit);
-            
-            if (bValidHit)
-            {
-                // HitMarker
-                if (WeaponData && WeaponData->HitMarkerUI)
-                {
-                    // TODO: Hit Marker
-                    // UUserWidget* UIHitMarker = CreateWidget<UUserWidget>(GetWorld()->GetFirstPlayerController(), WeaponData->HitMarkerUI);
-                    // if (UIHitMarker)
-                    // {
-                    //     UIHitMarker->AddToViewport();
-                    // }
-                }
-            }
-            if (bKilledPlayer)
-            {
-                // PlaySound2D
-                if (WeaponData && WeaponData->KillSound)
-                {
-                    UGameplayStatics::PlaySound2D(
-                        this,
-                        WeaponData->KillSound,
-                        1.0f,
-                        1.0f,
-                        0.0f,
-                        nullptr,
-                        nullptr,
-                        true
-                    );
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireBullet::KillSound is NULL"));
-                }
-            }
+        ProcessBulletHit(HitResult, MuzzleLocation);
+    }
+}
 
-            // Spawn bullet trace effect
-            if (WeaponData && WeaponData->BulletTraceClass)
-            {
-                FVector BulletEndLocation = HitResult.bBlockingHit ? HitResult.ImpactPoint : HitResult.TraceEnd;
-                BulletEndLocation = BulletEndLocation - MuzzleLocation;
+void AMasterWeapon::OnProjectileImpact(const FHitResult& HitResult, const FVector& Origin)
+{
+    if (!WeaponData)
+    {
+        return;
+    }
+
+    ProcessBulletHit(HitResult, Origin);
+}
 
-                FTransform SpawnTransform;
-                SpawnTransform.SetLocation(WeaponMesh->GetSocketLocation(FName("Muzzle")));
-                SpawnTransform.SetRotation(BulletEndLocation.Rotation().Quaternion());
-                SpawnTransform.SetScale3D(FVector(1.0f, 1.0f, 1.0f));
+void AMasterWeapon::ProcessBulletHit(const FHitResult& HitResult, const FVector& MuzzleLocation)
+{
+    if (!HitResult.GetActor())
+    {
+        return;
+    }
 
-                FActorSpawnParameters SpawnParams;
-                SpawnParams.Owner = this;
-                SpawnParams.Instigator = GetInstigator();
+    // Check if hit component is simulating physics
+    UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+    if (HitComponent && HitComponent->IsSimulatingPhysics())
+    {
+        // Apply physics impulse at impact point
+        FVector ImpulseDir = (HitResult.TraceEnd - HitResult.TraceStart).GetSafeNormal();
+        HitComponent->AddImpulseAtLocation(ImpulseDir * -1000.0f, HitResult.Location);
+    }
 
-                GetWorld()->SpawnActor<AActor>(WeaponData->BulletTraceClass, SpawnTransform, SpawnParams);
-            }
-        }
+    // Damage is applied once per victim bone at the end of the frame, together with the other pellets
+    if (UDamageAggregatorSubsystem* DamageAggregator = GetWorld()->GetSubsystem<UDamageAggregatorSubsystem>())
+    {
+        DamageAggregator->QueueHit(this, HitResult, WeaponData->Damage);
+    }
+    else
+    {
+        AActor* HitActor = HitResult.GetActor();
+        const bool bValidHit = ApplyDamage(HitResult, WeaponData->Damage) > 0.0f;
+        const bool bKilled = HitActor->Implements<UDamageable>() && IDamageable::Execute_IsDead(HitActor);
+        PlayHitFeedback(bValidHit, bKilled);
+    }
+
+    // Spawn bullet trace effect
+    if (WeaponData && WeaponData->BulletTraceClass)
+    {
+        FVector BulletEndLocation = HitResult.bBlockingHit ? HitResult.ImpactPoint : HitResult.TraceEnd;
+        BulletEndLocation = BulletEndLocation - MuzzleLocation;
+
+        FTransform SpawnTransform;
+        SpawnTransform.SetLocation(MuzzleLocation);
+        SpawnTransform.SetRotation(BulletEndLocation.Rotation().Quaternion());
+        SpawnTransform.SetScale3D(FVector(1.0f, 1.0f, 1.0f));
 
-        Hit = HitResult;
-        bReturnHit = true;
+        SpawnTracer(SpawnTransform);
     }
 }
 
-void AMasterWeapon::FireFX()
+void AMasterWeapon::FireFX(const FWeaponFireContext& Context)
 {
     if (!WeaponData)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireFX - WeaponData is NULL"));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::FireFX - WeaponData is NULL"));
         return;
     }
 
     if (!WeaponData->SoundAttenuation)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireFX - SoundAttenuation is NULL"));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::FireFX - SoundAttenuation is NULL"));
         return;
     }
 
     if (!WeaponData->SoundConcurrency)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireFX - SoundConcurrency is NULL"));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::FireFX - SoundConcurrency is NULL"));
         return;
     }
 
-    WeaponSystem->FireFX(WeaponData->FireSound, WeaponMesh->GetSocketLocation("Muzzle"), WeaponData->SoundAttenuation, WeaponData->SoundConcurrency);
+    WeaponSystem->FireFX(WeaponData->FireSound, Context.GetMuzzleLocation(), WeaponData->SoundAttenuation, WeaponData->SoundConcurrency);
 
     if (!WeaponData->MuzzleFlashVFX)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireFX - MuzzleFlashVFX is NULL"));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::FireFX - MuzzleFlashVFX is NULL"));
         return;
     }
 
-    WeaponSystem->MuzzleVFX(WeaponData->MuzzleFlashVFX, Muzzle);
+    // Muzzle is optional; without it the flash follows the mesh's Muzzle socket
+    WeaponSystem->MuzzleVFX(
+        WeaponData->MuzzleFlashVFX,
+        Muzzle ? Muzzle : WeaponMesh,
+        Muzzle ? NAME_None : MuzzleSocketName,
+        WeaponData->MuzzleFlashPoolMode
+    );
 
     WeaponSystem->FireMontage(WeaponData->BodyFireMontage);
 
     WeaponMesh->PlayAnimation(WeaponData->WeaponFireMontage, false);
 }
 
-void AMasterWeapon::FireBlankTracer()
+void AMasterWeapon::FireBlankTracer(const FWeaponFireContext& Context)
 {
     if (!WeaponData || !WeaponData->BulletTraceClass)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MasterWeapon::FireBlankTracer - WeaponData or BulletTraceClass is NULL"));
+        UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::FireBlankTracer - WeaponData or BulletTraceClass is NULL"));
         return;
     }
 
-    APlayerController* PC = GetWorld()->GetFirstPlayerController();
-    if (!PC || !PC->PlayerCameraManager)
-        return;
-
     // Apply camera shake (only for players)
-    ApplyCameraShake(PC);
+    ApplyCameraShake(Context.PlayerController);
 
-    FVector SocketLocation = WeaponMesh->GetSocketLocation(FName("Muzzle"));
-    FVector TraceEndLocation = PC->PlayerCameraManager->GetRootComponent()->GetComponentLocation()
-        + PC->PlayerCameraManager->GetActorForwardVector() * 20000.0f;
+    FVector SocketLocation = Context.GetMuzzleLocation();
+    FVector TraceEndLocation = Context.ViewLocation + Context.ViewForward * 20000.0f;
     FVector DirectionVector = TraceEndLocation - SocketLocation;
     FRotator Rotation = UKismetMathLibrary::MakeRotFromX(DirectionVector);
 
     FTransform NewTransform(Rotation, SocketLocation, FVector(1.0f));
-    GetWorld()->SpawnActor<AActor>(WeaponData->BulletTraceClass, NewTransform);
+    SpawnTracer(NewTransform);
 }
 
-void AMasterWeapon::RandPointInCircle(float Radius, float& PointX, float& PointY)
+AActor* AMasterWeapon::SpawnTracer(const FTransform& SpawnTransform)
 {
-    float Angle = FMath::RandRange(0.0f, 360.0f);
-    float DistanceFromCenter = FMath::RandRange(0.0f, Radius);
-    
-    // Convert polar coordinates to cartesian coordinates
-    PointX = DistanceFromCenter * FMath::Cos(FMath::DegreesToRadians(Angle));
-    PointY = DistanceFromCenter * FMath::Sin(FMath::DegreesToRadians(Angle));
+    UActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UActorPoolSubsystem>();
+    if (!ActorPool)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Owner = this;
+        SpawnParams.Instigator = GetInstigator();
+        return GetWorld()->SpawnActor<AActor>(WeaponData->BulletTraceClass, SpawnTransform, SpawnParams);
+    }
+
+    float Lifetime = WeaponData->TracerLifetime;
+    if (Lifetime <= 0.0f && WeaponData->BulletTraceClass->GetDefaultObject<AActor>()->InitialLifeSpan <= 0.0f)
+    {
+        Lifetime = DefaultTracerLifetime;
+    }
+    return ActorPool->Acquire(WeaponData->BulletTraceClass, SpawnTransform, Lifetime, this, GetInstigator());
 }
 
 bool AMasterWeapon::ApplyHit(const FHitResult HitResult, bool& ValidHit)
@@ -295,7 +374,7 @@ bool AMasterWeapon::ApplyHit(const FHitResult HitResult, bool& ValidHit)
     AActor* HitActor = HitResult.GetActor();
     
     // Hit된 액터가 있고, 그 액터가 유효한지 확인
-    if (!HitActor)
+    if (!HitActor || !WeaponData)
     {
         ValidHit = false;
         return false;
@@ -305,48 +384,104 @@ bool AMasterWeapon::ApplyHit(const FHitResult HitResult, bool& ValidHit)
 
     if (HitActor->Implements<UDamageable>())
     {
-        FPointDamageEvent DamageEvent(
-              WeaponData->Damage,           // Damage
-              HitResult,                    // HitInfo
-              -HitResult.ImpactNormal,      // ShotDirection (총알 방향)
-              nullptr                       // DamageTypeClass
-          );
-
-
-        APawn* OwnerPawn = WeaponSystem->CharacterRef;
-        AController* OwnerController = OwnerPawn ? OwnerPawn->GetController() : nullptr;
-
-        float ActualDamage = IDamageable::Execute_TakeDamage(
-            HitActor,
-            WeaponData->Damage,
-            DamageEvent,
-            HitResult.BoneName,
-            OwnerController,
-            this
-        );
-        ValidHit = ActualDamage > 0.0f;
-        if (ValidHit)
-        {
-            if (WeaponData && WeaponData->HitMarkerSound)
-            {
-                UGameplayStatics::PlaySound2D(
-                    this,                       // WorldContextObject
-                    WeaponData->HitMarkerSound, // Sound
-                    1.0f,                       // Volume Multiplier
-                    1.0f,                       // Pitch Multiplier
-                    0.0f,                       // Start Time
-                    nullptr,                    // Concurrency Settings
-                    nullptr,                    // Owning Actor
-                    true                        // Is UI Sound
-                );
-            }
-        }
+        ValidHit = ApplyDamage(HitResult, WeaponData->Damage) > 0.0f;
+        PlayHitFeedback(ValidHit, false);
         bIsDead = IDamageable::Execute_IsDead(HitActor);
     }
+    else
+    {
+        ValidHit = false;
+    }
     
     return bIsDead;
 }
 
+float AMasterWeapon::ApplyDamage(const FHitResult& HitResult, float Damage)
+{
+    AActor* HitActor = HitResult.GetActor();
+    if (!HitActor || !HitActor->Implements<UDamageable>())
+    {
+        return 0.0f;
+    }
+
+    FPointDamageEvent DamageEvent(
+          Damage,                       // Damage
+          HitResult,                    // HitInfo
+          -HitResult.ImpactNormal,      // ShotDirection (총알 방향)
+          nullptr                       // DamageTypeClass
+      );
+
+    APawn* OwnerPawn = WeaponSystem ? WeaponSystem->CharacterRef : nullptr;
+    AController* OwnerController = OwnerPawn ? OwnerPawn->GetController() : nullptr;
+
+    return IDamageable::Execute_TakeDamage(
+        HitActor,
+        Damage,
+        DamageEvent,
+        HitResult.BoneName,
+        OwnerController,
+        this
+    );
+}
+
+void AMasterWeapon::PlayHitFeedback(bool bValidHit, bool bKilled)
+{
+    if (!WeaponData)
+    {
+        return;
+    }
+
+    if (bValidHit)
+    {
+        if (WeaponData->HitMarkerSound)
+        {
+            UGameplayStatics::PlaySound2D(
+                this,                       // WorldContextObject
+                WeaponData->HitMarkerSound, // Sound
+                1.0f,                       // Volume Multiplier
+                1.0f,                       // Pitch Multiplier
+                0.0f,                       // Start Time
+                nullptr,                    // Concurrency Settings
+                nullptr,                    // Owning Actor
+                true                        // Is UI Sound
+            );
+        }
+
+        // HitMarker
+        if (WeaponData->HitMarkerUI)
+        {
+            // TODO: Hit Marker
+            // UUserWidget* UIHitMarker = CreateWidget<UUserWidget>(GetWorld()->GetFirstPlayerController(), WeaponData->HitMarkerUI);
+            // if (UIHitMarker)
+            // {
+            //     UIHitMarker->AddToViewport();
+            // }
+        }
+    }
+
+    if (bKilled)
+    {
+        // PlaySound2D
+        if (WeaponData->KillSound)
+        {
+            UGameplayStatics::PlaySound2D(
+                this,
+                WeaponData->KillSound,
+                1.0f,
+                1.0f,
+                0.0f,
+                nullptr,
+                nullptr,
+                true
+            );
+        }
+        else
+        {
+            UE_LOG(LogTPSWeapon, Warning, TEXT("MasterWeapon::PlayHitFeedback - KillSound is NULL"));
+        }
+    }
+}
+
 void AMasterWeapon::ApplyCameraShake(APlayerController* PC)
 {
     // Only apply camera shake for player-controlled characters
@@ -360,80 +495,80 @@ void AMasterWeapon::ApplyCameraShake(APlayerController* PC)
     }
 }
 
-bool AMasterWeapon::PerformCameraTrace(APlayerCameraManager* CameraManager, FHitResult& OutHitResult)
+bool AMasterWeapon::BuildFireContext(APlayerController* PC, FWeaponFireContext& OutContext) const
 {
-    if (!CameraManager || !WeaponData)
+    if (!PC || !PC->PlayerCameraManager || !WeaponSystem || !WeaponSystem->CharacterRef)
         return false;
 
-    UCameraComponent* Cam = WeaponSystem->CharacterRef->FindComponentByClass<UCameraComponent>();
-    if (!Cam)
-        return false;
-    
-    FVector StartLocation = Cam->GetComponentLocation();
-    FVector ForwardVector = Cam->GetForwardVector();
-    FVector EndLocation = StartLocation + (ForwardVector * WeaponData->MaxRange);
-    UE_LOG(LogTemp, Warning, TEXT("[PerformCameraTrace] StartLocation: %s, ForwardVector: %s, EndLocation: %s"),
-                *StartLocation.ToString(), *ForwardVector.ToString(), *EndLocation.ToString());
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(this);
-
-    return GetWorld()->LineTraceSingleByChannel(
-        OutHitResult,
-        StartLocation,
-        EndLocation,
-        ECollisionChannel::ECC_Visibility,
-        QueryParams
-    );
+    APlayerCameraManager* CameraManager = PC->PlayerCameraManager;
+    OutContext.PlayerController = PC;
+    OutContext.MuzzleTransform = WeaponMesh->GetSocketTransform(MuzzleSocketName);
+    OutContext.ViewLocation = CameraManager->GetRootComponent()->GetComponentLocation();
+    OutContext.ViewForward = CameraManager->GetActorForwardVector();
+    OutContext.ViewRight = CameraManager->GetActorRightVector();
+    OutContext.ViewUp = CameraManager->GetActorUpVector();
+
+    // Aim from the owner's own camera when it has one
+    if (UCameraComponent* Cam = WeaponSystem->CharacterRef->FindComponentByClass<UCameraComponent>())
+    {
+        OutContext.bHasAimCamera = true;
+        OutContext.AimStart = Cam->GetComponentLocation();
+        OutContext.AimEnd = OutContext.AimStart + (Cam->GetForwardVector() * WeaponData->MaxRange);
+    }
+
+    OutContext.AimQueryParams.AddIgnoredActor(this);
+    OutContext.BulletQueryParams.AddIgnoredActor(this);
+    OutContext.BulletQueryParams.AddIgnoredActor(Cast<AActor>(WeaponSystem->CharacterRef));
+    return true;
 }
 
-void AMasterWeapon::ExecuteFireSequence(const FHitResult& CameraHitResult)
+bool AMasterWeapon::PerformCameraTrace(const FWeaponFireContext& Context)
 {
-    FVector MuzzleLocation = WeaponMesh->GetSocketLocation(FName("Muzzle"));
-    FVector DirectionToTarget = MuzzleLocation - CameraHitResult.Location;
-    
-    // Perform muzzle trace
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(this);
-    
-    // DrawDebugLine(
-    //     GetWorld(),           // 월드
-    //     MuzzleLocation,        // 시작점
-    //     MuzzleLocation + (DirectionToTarget * -500.0f),          // 끝점
-    //     FColor::Yellow,       // 라인 색상
-    //     false,               // 지속적으로 그릴지 여부
-    //     5.0f,                // 지속 시간 (초)
-    //     0,                   // 우선순위
-    //     2.0f                 // 두께
-    // );
-    FHitResult MuzzleHitResult;
-    bool bMuzzleHit = GetWorld()->LineTraceSingleByChannel(
-        MuzzleHitResult,
-        MuzzleLocation,
-        MuzzleLocation + (DirectionToTarget * -500.0f),
-        COLLISION_BULLET,
-        QueryParams
-    );
+    if (!Context.bHasAimCamera || !WeaponData)
+        return false;
+
+    UE_LOG(LogTPSWeapon, Verbose, TEXT("[PerformCameraTrace] StartLocation: %s, EndLocation: %s"),
+                *Context.AimStart.ToString(), *Context.AimEnd.ToString());
 
-    FireFX();
-    FireBullet(CameraHitResult, false);
+    PendingFireContexts.Add(Context);
+
+    if (UHitscanSubsystem* Hitscan = GetWorld()->GetSubsystem<UHitscanSubsystem>())
+    {
+        Hitscan->QueueAimTrace(this, Context.AimStart, Context.AimEnd, ECollisionChannel::ECC_Visibility, Context.AimQueryParams);
+        return true;
+    }
+
+    // No async batching in this world - trace synchronously
+    FHitResult AimHit;
+    GetWorld()->LineTraceSingleByChannel(
+        AimHit,
+        Context.AimStart,
+        Context.AimEnd,
+        ECollisionChannel::ECC_Visibility,
+        Context.AimQueryParams
+    );
+    OnAimTraceComplete(AimHit);
+    return true;
 }
 
 void AMasterWeapon::Fire()
 {
+    SCOPE_CYCLE_COUNTER(STAT_WeaponFire);
+
     // Early exits
     if (bReloading)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[Fire] Blocked: bReloading = true"));
+        UE_LOG(LogTPSWeapon, Verbose, TEXT("[Fire] Blocked: bReloading = true"));
         return;
     }
 
     if (!WeaponSystem || !WeaponData)
     {
-        UE_LOG(LogTemp, Error, TEXT("[Fire] WeaponSystem or WeaponData is NULL!"));
+        UE_LOG(LogTPSWeapon, Error, TEXT("[Fire] WeaponSystem or WeaponData is NULL!"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[Fire] Called - CurrentAmmo: %d, AmmoCount: %d"),
+    UE_LOG(LogTPSWeapon, Verbose, TEXT("[Fire] Called - CurrentAmmo: %d, AmmoCount: %d"),
         WeaponSystem->Weapon_Details.Weapon_Data.CurrentAmmo,
         WeaponSystem->Weapon_Details.Weapon_Data.Ammo_Count);
 
@@ -455,34 +590,125 @@ void AMasterWeapon::Fire()
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[Fire] FireCheck PASSED - Executing fire logic"));
+    UE_LOG(LogTPSWeapon, Verbose, TEXT("[Fire] FireCheck PASSED - Executing fire logic"));
 
     // Get PlayerController and CameraManager
     APlayerController* PC = GetWorld()->GetFirstPlayerController();
     if (!PC || !PC->PlayerCameraManager)
     {
-        UE_LOG(LogTemp, Error, TEXT("[Fire] PlayerController or CameraManager is NULL!"));
+        UE_LOG(LogTPSWeapon, Error, TEXT("[Fire] PlayerController or CameraManager is NULL!"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[Fire] PlayerController found"));
+    // Muzzle, view basis and trace params are resolved once and shared by the whole shot
+    FWeaponFireContext Context;
+    if (!BuildFireContext(PC, Context))
+    {
+        UE_LOG(LogTPSWeapon, Warning, TEXT("[Fire] WeaponSystem->CharacterRef is NULL"));
+        if (IsWeaponDebugEnabled() && GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("WeaponSystem->CharacterRef is NULL"));
+        }
+        return;
+    }
+
+    // Recoil pattern restarts after a pause in fire
+    const double Now = GetWorld()->GetTimeSeconds();
+    ConsecutiveShots = (LastShotTime >= 0.0 && Now - LastShotTime <= WeaponData->RecoilResetTime) ? ConsecutiveShots + 1 : 0;
+    LastShotTime = Now;
+    Context.ShotIndex = ConsecutiveShots;
 
     // Apply camera shake (only for players)
     ApplyCameraShake(PC);
 
+    // Feedback plays right away; the bullets resolve once the traces come back
+    FireFX(Context);
+
     // Perform camera trace
-    FHitResult CameraHitResult;
-    if (PerformCameraTrace(PC->PlayerCameraManager, CameraHitResult))
+    if (!PerformCameraTrace(Context))
     {
-        // Hit something - fire at target
-        ExecuteFireSequence(CameraHitResult);
+        // No camera to aim with - fire blank tracer
+        FireBlankTracer(Context);
     }
-    else
+}
+
+void AMasterWeapon::RunFireBenchmark(int32 NumShots)
+{
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    FWeaponFireContext Context;
+    if (!WeaponData || !BuildFireContext(PC, Context))
     {
-        // Didn't hit anything - fire blank tracer
-        FireFX();
-        FireBlankTracer();
+        UE_LOG(LogTPSWeapon, Warning, TEXT("[Fire] Benchmark needs weapon data and an owner with a player camera"));
+        return;
     }
+
+    NumShots = FMath::Max(NumShots, 1);
+    const int32 NumPellets = FMath::Max(WeaponData->BurstAmount, 1);
+    const float SpreadRadius = FMath::Tan(WeaponData->BulletSpread) * 10.0f;
+
+    // The spread sequence is put back afterwards, so the benchmark does not shift the weapon's next real shots
+    const FWeaponSpreadGenerator SavedSpread = Spread;
+    FVector Checksum = FVector::ZeroVector;
+
+    // A shot's game-thread work up to the trace submit: context, recoil, pellet offsets and the per-shot log lines.
+    // No ammo, traces, FX or damage, so nothing outlives the timed loop.
+    auto TimeShots = [&](int32 Shots, bool bLegacyLogging)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Shot = 0; Shot < Shots; ++Shot)
+        {
+            FWeaponFireContext ShotContext;
+            BuildFireContext(PC, ShotContext);
+            const FVector MuzzleLocation = ShotContext.GetMuzzleLocation();
+            const FVector2D Recoil = FWeaponSpreadGenerator::GetRecoilOffset(WeaponData->RecoilPattern, Shot);
+
+            if (bLegacyLogging)
+            {
+                // What Fire, PerformCameraTrace and FireBullet logged per shot before LogTPSWeapon
+                UE_LOG(LogTemp, Log, TEXT("[Fire] Called - CurrentAmmo: %d, AmmoCount: %d"),
+                    WeaponSystem->Weapon_Details.Weapon_Data.CurrentAmmo, WeaponSystem->Weapon_Details.Weapon_Data.Ammo_Count);
+                UE_LOG(LogTemp, Log, TEXT("[Fire] FireCheck PASSED - Executing fire logic"));
+                UE_LOG(LogTemp, Log, TEXT("[Fire] PlayerController found"));
+                UE_LOG(LogTemp, Warning, TEXT("[PerformCameraTrace] StartLocation: %s, ForwardVector: %s, EndLocation: %s"),
+                    *ShotContext.AimStart.ToString(), *ShotContext.ViewForward.ToString(), *ShotContext.AimEnd.ToString());
+                UE_LOG(LogTemp, Warning, TEXT("[FireBullet] Hit.Location: %s, bBlockingHit: %d"), *ShotContext.AimEnd.ToString(), 0);
+            }
+            else
+            {
+                UE_LOG(LogTPSWeapon, Verbose, TEXT("[Fire] Called - CurrentAmmo: %d, AmmoCount: %d"),
+                    WeaponSystem->Weapon_Details.Weapon_Data.CurrentAmmo, WeaponSystem->Weapon_Details.Weapon_Data.Ammo_Count);
+                UE_LOG(LogTPSWeapon, Verbose, TEXT("[Fire] FireCheck PASSED - Executing fire logic"));
+                UE_LOG(LogTPSWeapon, Verbose, TEXT("[PerformCameraTrace] StartLocation: %s, EndLocation: %s"),
+                    *ShotContext.AimStart.ToString(), *ShotContext.AimEnd.ToString());
+                UE_LOG(LogTPSWeapon, Verbose, TEXT("[FireBullet] Hit.Location: %s, bBlockingHit: %d"), *ShotContext.AimEnd.ToString(), 0);
+                UE_LOG(LogTPSWeapon, Verbose, TEXT("[FireBullet] MuzzleLocation: %s"), *MuzzleLocation.ToString());
+            }
+
+            for (int32 Pellet = 0; Pellet < NumPellets; ++Pellet)
+            {
+                const FVector2D Point = Recoil + Spread.SampleDisk(SpreadRadius);
+                const FVector SpreadAdjustedHitLocation = ShotContext.AimEnd + ShotContext.ViewRight * Point.X + ShotContext.ViewUp * Point.Y;
+                if (bLegacyLogging)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("[FireBullet] MuzzleLocation: %s"), *MuzzleLocation.ToString());
+                    UE_LOG(LogTemp, Warning, TEXT("[FireBullet] SpreadAdjustedHitLocation: %s"), *SpreadAdjustedHitLocation.ToString());
+                }
+                Checksum += SpreadAdjustedHitLocation - MuzzleLocation;
+            }
+        }
+        return (FPlatformTime::Seconds() - StartTime) * 1e6 / Shots;
+    };
+
+    // Warm up caches so neither run pays for the first touch
+    TimeShots(FMath::Min(NumShots, 100), false);
+    const double LegacyMicroseconds = TimeShots(NumShots, true);
+    const double CurrentMicroseconds = TimeShots(NumShots, false);
+    Spread = SavedSpread;
+
+    UE_LOG(LogTPSWeapon, Display, TEXT("[Fire] Benchmark: %d shots x %d pellets, %.2f us/shot with LogTemp Warning logging, %.2f us/shot with LogTPSWeapon (%.1fx, tps.Weapon.Debug %s, checksum %.0f)"),
+        NumShots, NumPellets, LegacyMicroseconds, CurrentMicroseconds,
+        CurrentMicroseconds > 0.0 ? LegacyMicroseconds / CurrentMicroseconds : 0.0,
+        IsWeaponDebugEnabled() ? TEXT("on") : TEXT("off"), Checksum.Size());
 }
 
 void AMasterWeapon::Reload()
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Weapon/WeaponSpread.h"
+#include "Curves/CurveVector.h"
+
+namespace
+{
+	/** Fixed so every build and every machine shares the same table */
+	constexpr int32 DiskTableSeed = 0x53505244; // "SPRD"
+}
+
+void FWeaponSpreadGenerator::Initialize(int32 Seed)
+{
+	Stream.Initialize(Seed);
+}
+
+FVector2D FWeaponSpreadGenerator::SampleDisk(float Radius)
+{
+	const TArray<FVector2f>& Table = GetUnitDiskTable();
+	const FVector2f& Sample = Table[Stream.RandHelper(DiskTableSize)];
+	return FVector2D(Sample.X * Radius, Sample.Y * Radius);
+}
+
+FVector2D FWeaponSpreadGenerator::GetRecoilOffset(const UCurveVector* RecoilPattern, int32 ShotIndex)
+{
+	if (!RecoilPattern)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FVector Offset = RecoilPattern->GetVectorValue(static_cast<float>(ShotIndex));
+	return FVector2D(Offset.X, Offset.Y);
+}
+
+const TArray<FVector2f>& FWeaponSpreadGenerator::GetUnitDiskTable()
+{
+	static const TArray<FVector2f> Table = []()
+	{
+		FRandomStream TableStream(DiskTableSeed);
+
+		TArray<FVector2f> Samples;
+		Samples.SetNumUninitialized(DiskTableSize);
+		for (int32 Index = 0; Index < DiskTableSize; ++Index)
+		{
+			// One sample per equal-area ring, so the radial density is uniform even with only 256 points
+			const float Angle = TableStream.FRandRange(0.0f, UE_TWO_PI);
+			const float Distance = FMath::Sqrt((Index + TableStream.FRand()) / DiskTableSize);
+			Samples[Index] = FVector2f(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle));
+		}
+		return Samples;
+	}();
+	return Table;
+}
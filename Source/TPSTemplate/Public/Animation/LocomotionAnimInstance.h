@@ -9,8 +9,38 @@
 #include "Library/AnimationState.h"
 #include "LocomotionAnimInstance.generated.h"
 
+/** Game-thread state the locomotion update reads, copied once per update so the logic can run on a worker thread */
+struct FLocomotionSnapshot
+{
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	bool bIsFalling = false;
+	FRotator ActorRotation = FRotator::ZeroRotator;
+	FVector ActorVelocity = FVector::ZeroVector;
+	EAnimationState AnimationState = EAnimationState::Unarmed;
+
+	/** Player_Base-only state below is valid only when set */
+	bool bIsPlayer = false;
+	bool bIsPistolEquip = false;
+	bool bIsRifleEquip = false;
+	bool bIsCrouching = false;
+	bool bIsSprint = false;
+	bool bIsJump = false;
+	bool bIsAim = false;
+	ELandState LandState = ELandState::Normal;
+	float Pitch = 0.0f;
+	float TurnRate = 0.0f;
+
+	/** Curves of the last evaluated pose */
+	float IsTurnCurve = 0.0f;
+	float DistanceCurve = 0.0f;
+};
+
 /**
- * 
+ * Locomotion variables for the character anim graphs
+ *
+ * NativeUpdateAnimation only snapshots the owner; the locomotion logic runs in NativeThreadSafeUpdateAnimation.
+ * Skipped update-rate-optimization (URO) frames are counted, and the time they saved is reported in stat TPSTemplate.
  */
 UCLASS()
 class TPSTEMPLATE_API ULocomotionAnimInstance : public UAnimInstance
@@ -23,9 +53,22 @@ private:
 
 	void TurnInPlace();
 
+	/** Copy everything the thread-safe update needs from the character (game thread) */
+	void GatherSnapshot();
+
+	FLocomotionSnapshot Snapshot;
+
+	/** Delta time of the running thread-safe update */
+	float UpdateDeltaSeconds = 0.0f;
+
+	/** URO bookkeeping for the time-saved readout */
+	uint64 LastUpdateFrame = 0;
+	double AverageUpdateSeconds = 0.0;
+
 public:
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 	void UpdateCharacterState();
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "TPSTemplateCharacter.h"
 #include "Components/TimelineComponent.h"
+#include "Weapon/WeaponFireScheduler.h"
 #include "Player_Base.generated.h"
 
 // Forward declarations
@@ -96,6 +97,9 @@ protected:
 	UPROPERTY()
 	FTimeline ShoulderCameraTimeline;
 
+	/** Paces automatic fire from Tick at the equipped weapon's FireRate */
+	FWeaponFireScheduler FireScheduler;
+
 	
 protected:
 	// Input Handling Functions
@@ -120,8 +124,9 @@ protected:
 
 	// Weapon Functions
 	void StopFire();
-	void HandleFiring();
+	void HandleFiring(float DeltaTime);
 	bool CanFire();
+	class AMasterWeapon* GetEquippedWeapon() const;
 	bool CanSwitchWeapon();
 
 	UFUNCTION()
@@ -155,6 +155,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
 	bool bInteracting = false;
 
+	/** False while the weapon cycles between shots (set from the fire scheduler each frame; writes are overwritten) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
 	bool bCanFire = true;
 
@@ -198,6 +199,8 @@ public:
 	void StartRagdoll();
 
 	UInventorySystem* GetInventorySystem() const { return InventorySystem; }
+
+	UEquipmentSystem* GetEquipmentSystem() const { return EquipmentSystem; }
 	
 	// Virtual functions that can be overridden by player/AI
 	virtual void Interact();
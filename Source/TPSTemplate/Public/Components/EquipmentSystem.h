@@ -12,6 +12,7 @@ class UInventorySystem;
 class AMasterWeapon;
 class ATPSTemplateCharacter;
 class UWeaponData;
+struct FInventorySaveData;
 
 UENUM(BlueprintType)
 enum class EWeaponState : uint8
@@ -71,7 +72,16 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	bool IsEquipped(EEquipmentSlot Slot);
+
+	/** Append equipped items (and the spawned weapons' ammo) to a save snapshot */
+	void WriteSaveData(FInventorySaveData& OutData) const;
+
+	/** Re-equip items from a loaded snapshot (assets must already be loaded), clear slots it does not list and restore weapon ammo */
+	void ApplySaveData(const FInventorySaveData& Data);
 protected:
+	/** Destroy the slot's spawned actor and forget what it held */
+	void ClearSlot(EEquipmentSlot Slot);
+
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
@@ -7,6 +7,9 @@
 #include "Hurtbox.generated.h"
 
 class ATPSTemplateCharacter;
+class USkeletalMeshComponent;
+class USkinnedAsset;
+class UPhysicsAsset;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class TPSTEMPLATE_API UHurtbox : public UActorComponent
@@ -19,19 +22,54 @@ public:
 
 	ATPSTemplateCharacter* CharacterRef = nullptr;
 
-	UPROPERTY()
-	FTimerHandle RecoveryTimer;
 public:
+	/** Multiplier by bone name; prefer GetDamageMultiplierForHit when a hit result is available */
 	UFUNCTION(BlueprintCallable, Category = "Hurtbox")
 	float GetDamageMultiplier(const FName HitBoneName) const;
 
+	/** Multiplier for a hit on the owner's mesh - a single table read through the hit's physics body */
+	float GetDamageMultiplierForHit(const FHitResult& HitResult) const;
+
+	/**
+	 * Flatten DamageMultipliers into per-bone / per-body tables of the owner's mesh
+	 * Bones without an entry inherit their parent's multiplier. Call again after changing DamageMultipliers or the mesh at runtime
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hurtbox")
+	void BakeDamageMultipliers();
+
+	/** Simulate BoneName briefly and push it along HitDirection; budget and LOD are decided by UHitReactionSubsystem */
 	void ApplyHitReaction(const FVector& HitLocation, const FVector& HitDirection, const FName BoneName, float Force);
 
+	/** End every active hit reaction of this character */
 	UFUNCTION(BlueprintCallable, Category = "Hurtbox")
 	void RecoverFromHit();
+
+	/** Return BoneName to animation (UHitReactionSubsystem, when its reaction recovered or was evicted) */
+	void EndBoneReaction(FName BoneName);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 private:
-	FName ActivatedBoneName = NAME_None;
+	/** True while the baked tables still describe Mesh's current skeleton and physics asset */
+	bool IsBakeValid(const USkeletalMeshComponent* Mesh) const;
+
+	/** Multiplier of BoneIndex: its own entry, else the nearest ancestor's, else 1 (the rule the bake applies to every bone) */
+	float FindInheritedMultiplier(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex) const;
+
+	/** Mesh bone index -> multiplier */
+	TArray<float> BoneMultipliers;
+
+	/** Mesh physics body index (FHitResult::Item on skeletal hits) -> multiplier */
+	TArray<float> BodyMultipliers;
+
+	/** Bone name -> multiplier for every bone of the baked skeleton, so name-only hits skip the skeleton's bone lookup */
+	TMap<FName, float> BoneMultipliersByName;
+
+	TWeakObjectPtr<USkeletalMeshComponent> BakedMesh;
+	TWeakObjectPtr<USkinnedAsset> BakedSkinnedAsset;
+	TWeakObjectPtr<UPhysicsAsset> BakedPhysicsAsset;
 
 	UPROPERTY(EditAnywhere, Category = "Hurtbox|Hit Reaction")
 	float MinRecoveryTime = 0.3f;
@@ -5,8 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Data/InventoryTypes.h"
+#include "Data/InventoryGrid.h"
+#include "Engine/StreamableManager.h"
 #include "InventorySystem.generated.h"
 
+struct FInventorySaveData;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChangedDelegate);
+
 /**
  * Grid-based inventory system (Resident Evil style)
  * Items have different sizes and occupy multiple grid cells
@@ -19,9 +25,17 @@ class TPSTEMPLATE_API UInventorySystem : public UActorComponent
 public:
 	UInventorySystem();
 
+	virtual void PostInitProperties() override;
+
 protected:
 	virtual void BeginPlay() override;
 
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Client: rebuild grid, indices and weight after replicated item changes arrive */
+	void OnItemsReplicated();
+
 public:
 	//==============================================================================
 	// Public API
@@ -29,20 +43,47 @@ public:
 
 	/** Check if an item can be placed at the specified position */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-	bool CanPlaceItem(UItemData* ItemData, int32 GridRow, int32 GridCol) const;
+	bool CanPlaceItem(UItemData* ItemData, int32 GridRow, int32 GridCol, bool bRotated = false) const;
 
 	/** Add an item to the inventory at the specified position */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-	bool AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol, int32 Quantity = 1);
+	bool AddItem(UItemData* ItemData, int32 GridRow, int32 GridCol, int32 Quantity = 1, bool bRotated = false);
 
 	/** Add an item to the inventory at the specified position */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool TryAddItemEmptySpot(UItemData* ItemData, int32 Quantity = 1);
 	
+	/**
+	 * Add several items as one transaction: all placements are planned against a scratch copy of the grid,
+	 * then committed together with a single OnInventoryChanged broadcast.
+	 * bAllOrNothing: any failed request cancels the whole batch; otherwise failed requests are skipped and reported
+	 */
+	FItemAddBatchResult AddItems(TArrayView<const FItemAddRequest> Requests, bool bAllOrNothing = false);
+
+	/** Add an item using best-fit placement (tightest spot, optionally rotated) instead of first-fit */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool TryAddItemBestFit(UItemData* ItemData, int32 Quantity = 1, bool bAllowRotation = true);
+
+	/** Repack all placed items (largest first, best-fit) to defragment the grid; layout is unchanged on failure */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool AutoArrange(bool bAllowRotation = true);
+
+	/** Merge partial stacks of the same item into as few slots as possible, linear in item count (returns slots freed) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 MergeAllStacks();
+
+	/** Rotate a placed item 90 degrees in place (top-left anchor stays) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool RotateItem(FGuid InstanceId);
+
 	/** Remove an item from the inventory by InstanceId */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool RemoveItem(FGuid InstanceId);
 
+	/** Remove part of a stack (removes the slot when it reaches zero) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool RemoveItemQuantity(FGuid InstanceId, int32 Amount);
+
 	/** Move an existing item to a new grid position */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool MoveItem(FGuid InstanceId, int32 GridRow, int32 GridCol);
@@ -56,7 +97,7 @@ public:
 
 	/** Get all items in the inventory */
 	UFUNCTION(BlueprintPure, Category = "Inventory")
-	const TArray<FItemSlot>& GetItems() const { return Items; }
+	const TArray<FItemSlot>& GetItems() const { return ItemList.Items; }
 
 	/** Get current/max weight */
 	UFUNCTION(BlueprintPure, Category = "Inventory")
@@ -65,6 +106,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Inventory")
 	float GetMaxWeight() const { return MaxWeight; }
 
+	/** Fraction of grid cells that are occupied (0..1) */
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	float GetPackDensity() const;
+
 	/** Check if inventory is over weight limit */
 	UFUNCTION(BlueprintPure, Category = "Inventory")
 	bool IsOverWeight() const { return CurrentWeight > MaxWeight; }
@@ -77,10 +122,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool GetItemAtCellCopy(int32 Row, int32 Col, FItemSlot& OutItem);
 
+	/**
+	 * Async-load item data assets before populating slots from soft references,
+	 * so slots resolve from memory instead of a blocking load (OnLoaded runs on the game thread).
+	 * Replicated slots go through this before the grid is rebuilt.
+	 */
+	void PreloadItemData(const TArray<TSoftObjectPtr<UItemData>>& ItemAssets, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** Append every slot to a save snapshot (item assets go into the snapshot's asset table) */
+	void WriteSaveData(FInventorySaveData& OutData) const;
+
+	/**
+	 * Replace the contents with a loaded snapshot; item assets must already be loaded
+	 * (see UInventorySaveSubsystem). Slots whose cells are taken or out of bounds are kept unplaced
+	 */
+	void ApplySaveData(const FInventorySaveData& Data);
+
+	/**
+	 * Listen server: measure replication bytes per pickup. Sends NumFrames frames idle, then NumFrames frames with
+	 * one ItemData pickup each, and logs the extra bytes per pickup; the added items are removed afterwards.
+	 * Run via tps.Inventory.NetBenchmark with a client connected
+	 */
+	void RunNetBenchmark(UItemData* ItemData, int32 NumFrames);
+
 	/** Initialize the grid (called automatically in BeginPlay, but can be called manually if needed) */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void InitializeGrid();
 
+	/** Fired once per successful mutation (once per batch for AddItems) */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnInventoryChangedDelegate OnInventoryChanged;
+
 protected:
 	//==============================================================================
 	// Grid Configuration
@@ -89,7 +161,8 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Config")
 	int32 RowCapacity = 6;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Config")
+	/** Limited to 64 columns (one occupancy bitmask per row) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Config", meta = (ClampMin = "1", ClampMax = "64"))
 	int32 ColCapacity = 6;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Config")
@@ -99,13 +172,28 @@ protected:
 	// Inventory Data
 	//==============================================================================
 
-	/** All items in the inventory (placed and unplaced) */
-	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Data")
-	TArray<FItemSlot> Items;
+	/** All items in the inventory (placed and unplaced), delta-replicated per slot */
+	UPROPERTY(Replicated)
+	FInventoryItemArray ItemList;
 
-	/** Grid state: each cell stores the InstanceId of the item occupying it */
+	/** Grid state: each cell stores the index into Items of the item occupying it (INDEX_NONE = empty) */
 	UPROPERTY()
-	TArray<FGuid> GridCells;
+	TArray<int32> GridCells;
+
+	/** Per-row occupancy bitmasks, kept in sync with GridCells (used for fit tests and spot search) */
+	FInventoryOccupancyGrid Occupancy;
+
+	/** InstanceId -> index into Items, kept in sync on add/remove (swap-remove re-points the moved item) */
+	TMap<FGuid, int32> ItemIndexById;
+
+	/** ItemData -> indices into Items of stacks that still have room, so stacking only visits same-type slots (unordered) */
+	TMap<UItemData*, TArray<int32>> OpenStacksByItem;
+
+	/** Parallel to Items: position of each slot in its OpenStacksByItem list (INDEX_NONE = full or not stackable) */
+	TArray<int32> OpenStackPositions;
+
+	/** Keeps the most recent item data preload alive until the assets are referenced by slots */
+	TSharedPtr<FStreamableHandle> PreloadHandle;
 
 	/** Current total weight of all items */
 	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Data")
@@ -124,12 +212,51 @@ protected:
 	/** Get the item at a specific grid cell (C++ only) */
 	FItemSlot* GetItemAtCell(int32 Row, int32 Col);
 
-	/** Update grid cells occupied by an item */
-	void OccupyGridCells(const FItemSlot& Item);
+	/** Add/remove Items[ItemIndex] from OpenStacksByItem to match whether it still has stack room (O(1)) */
+	void UpdateOpenStack(int32 ItemIndex);
+
+	/** Swap-remove Items[ItemIndex] from its OpenStacksByItem list, if it is in one */
+	void RemoveOpenStack(int32 ItemIndex);
+
+	/** Flag Items[ItemIndex] for the next replication delta (call after any change to the slot) */
+	void MarkItemDirty(int32 ItemIndex);
+
+	/** Rebuild GridCells, occupancy, indices and weight from the item list (client side of replication) */
+	void RebuildDerivedState();
 
-	/** Clear grid cells occupied by an item */
-	void ClearGridCells(const FItemSlot& Item);
+	/** Broadcast OnInventoryChanged */
+	void NotifyInventoryChanged();
+
+	/** Stack Quantity into existing non-full stacks of ItemData (returns the quantity left over) */
+	int32 StackIntoExisting(UItemData* ItemData, int32 Quantity);
+
+	/** Best-fit spot for a footprint, trying the rotated orientation too if allowed */
+	bool FindBestFitSpot(const FItemFootprint& Footprint, bool bAllowRotation, int32& OutRow, int32& OutCol, bool& bOutRotated) const;
+
+	/** Get the index into Items for an InstanceId (INDEX_NONE if not found) */
+	int32 FindItemIndex(const FGuid& InstanceId) const;
+
+	/** Append a slot to Items and register it in ItemIndexById (returns the new index) */
+	int32 AddItemSlot(const FItemSlot& NewSlot);
+
+	/** Swap-remove Items[ItemIndex] and keep ItemIndexById/GridCells pointing at the moved item */
+	void RemoveItemSlotAt(int32 ItemIndex);
+
+	/** Update grid cells occupied by Items[ItemIndex] */
+	void OccupyGridCells(int32 ItemIndex);
+
+	/** Clear grid cells occupied by Items[ItemIndex] */
+	void ClearGridCells(int32 ItemIndex);
+
+	/** Apply a weight change from a single add/stack/remove (CurrentWeight is never rescanned on hot paths) */
+	void ApplyWeightDelta(float Delta);
+
+	/** Sum the weight of every slot (full O(n) scan, for recovery and verification only) */
+	float ComputeTotalWeight() const;
 
 	/** Recalculate total weight */
 	void RecalculateWeight();
+
+	/** Debug builds: cross-check the incremental CurrentWeight against a full recompute */
+	void VerifyWeight() const;
 };
@@ -18,6 +18,7 @@ class ATPSTemplateCharacter;
 class UWeaponData;
 class UUserWidget;
 class UNiagaraSystem;
+enum class EMuzzleFlashPoolMode : uint8;
 class USceneComponent;
 
 USTRUCT(BlueprintType)
@@ -75,7 +76,8 @@ public:
 
 	void EmptyFX(USoundBase* Sound);
 
-	void MuzzleVFX(UNiagaraSystem* NiagaraSystem, USceneComponent* AttachToComponent);
+	/** Play the muzzle flash attached to AttachToComponent (at SocketName), reusing components per PoolMode */
+	void MuzzleVFX(UNiagaraSystem* NiagaraSystem, USceneComponent* AttachToComponent, FName SocketName, EMuzzleFlashPoolMode PoolMode);
 
 	void FireMontage(UAnimMontage* FireAnim);
 
@@ -106,4 +108,9 @@ public:
 
 	UPROPERTY()
 	ATPSTemplateCharacter* CharacterRef;
+
+private:
+	/** Muzzle flash kept alive between shots for EMuzzleFlashPoolMode::Persistent */
+	UPROPERTY(Transient)
+	UNiagaraComponent* MuzzleFlashComponent;
 };
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bitboard occupancy for the grid inventory
+ * One uint64 mask per row (bit N = column N occupied), so a WxH fit test is H mask compares
+ * and a first-fit search is a handful of shift/AND ops per row instead of a per-cell scan
+ */
+struct FInventoryOccupancyGrid
+{
+	/** Rows are stored as a single uint64, so a grid can be at most 64 columns wide */
+	static constexpr int32 MaxColumns = 64;
+
+	//==============================================================================
+	// Setup
+	//==============================================================================
+
+	/** Reset to an empty grid of the given size */
+	void Init(int32 InRows, int32 InCols)
+	{
+		check(InCols <= MaxColumns);
+
+		Rows = FMath::Max(0, InRows);
+		Cols = FMath::Clamp(InCols, 0, MaxColumns);
+		RowMasks.Init(0, Rows);
+	}
+
+	int32 GetRows() const { return Rows; }
+	int32 GetCols() const { return Cols; }
+
+	//==============================================================================
+	// Queries
+	//==============================================================================
+
+	/** Check if a Width x Height rectangle at (Row, Col) is inside the grid and fully free */
+	bool IsFree(int32 Row, int32 Col, int32 Width, int32 Height) const
+	{
+		if (!IsInBounds(Row, Col, Width, Height))
+		{
+			return false;
+		}
+
+		const uint64 Span = MakeSpanMask(Col, Width);
+		for (int32 r = Row; r < Row + Height; ++r)
+		{
+			if (RowMasks[r] & Span)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Check if a single cell is occupied */
+	bool IsCellOccupied(int32 Row, int32 Col) const
+	{
+		return Row >= 0 && Row < Rows && Col >= 0 && Col < Cols
+			&& (RowMasks[Row] & (uint64(1) << Col)) != 0;
+	}
+
+	/**
+	 * Find the first free Width x Height rectangle in row-major order
+	 * Same result as scanning every (Row, Col) with IsFree, without the per-cell work
+	 */
+	bool FindFirstFit(int32 Width, int32 Height, int32& OutRow, int32& OutCol) const
+	{
+		FRowFitArray RowFits;
+		if (!BuildRowFits(Width, Height, RowFits))
+		{
+			return false;
+		}
+
+		for (int32 Row = 0; Row <= Rows - Height; ++Row)
+		{
+			const uint64 Fit = GetRectFits(RowFits, Row, Height);
+			if (Fit)
+			{
+				OutRow = Row;
+				OutCol = static_cast<int32>(FMath::CountTrailingZeros64(Fit));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Find the free Width x Height rectangle whose perimeter touches the most occupied cells or grid edges
+	 * (contact-point rule from maximal-rectangles packing); ties keep the first position in row-major order
+	 */
+	bool FindBestFit(int32 Width, int32 Height, int32& OutRow, int32& OutCol, int32& OutScore) const
+	{
+		FRowFitArray RowFits;
+		if (!BuildRowFits(Width, Height, RowFits))
+		{
+			return false;
+		}
+
+		int32 BestScore = -1;
+		for (int32 Row = 0; Row <= Rows - Height; ++Row)
+		{
+			uint64 Fit = GetRectFits(RowFits, Row, Height);
+			while (Fit)
+			{
+				const int32 Col = static_cast<int32>(FMath::CountTrailingZeros64(Fit));
+				Fit &= Fit - 1;
+
+				const int32 Score = GetContactScore(Row, Col, Width, Height);
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					OutRow = Row;
+					OutCol = Col;
+				}
+			}
+		}
+
+		OutScore = BestScore;
+		return BestScore >= 0;
+	}
+
+	/** Number of perimeter cells of a rectangle that border an occupied cell or the grid edge */
+	int32 GetContactScore(int32 Row, int32 Col, int32 Width, int32 Height) const
+	{
+		const uint64 Span = MakeSpanMask(Col, Width);
+
+		int32 Score = 0;
+		Score += Row == 0 ? Width : FMath::CountBits(RowMasks[Row - 1] & Span);
+		Score += Row + Height == Rows ? Width : FMath::CountBits(RowMasks[Row + Height] & Span);
+
+		for (int32 r = Row; r < Row + Height; ++r)
+		{
+			Score += Col == 0 ? 1 : static_cast<int32>((RowMasks[r] >> (Col - 1)) & 1);
+			Score += Col + Width == Cols ? 1 : static_cast<int32>((RowMasks[r] >> (Col + Width)) & 1);
+		}
+		return Score;
+	}
+
+	/** Number of occupied cells (for pack density) */
+	int32 GetOccupiedCount() const
+	{
+		int32 Count = 0;
+		for (const uint64 Mask : RowMasks)
+		{
+			Count += FMath::CountBits(Mask);
+		}
+		return Count;
+	}
+
+	//==============================================================================
+	// Mutation
+	//==============================================================================
+
+	/** Mark a rectangle as occupied (caller guarantees it is in bounds) */
+	void Mark(int32 Row, int32 Col, int32 Width, int32 Height)
+	{
+		const uint64 Span = MakeSpanMask(Col, Width);
+		for (int32 r = Row; r < Row + Height; ++r)
+		{
+			RowMasks[r] |= Span;
+		}
+	}
+
+	/** Mark a rectangle as free (caller guarantees it is in bounds) */
+	void Clear(int32 Row, int32 Col, int32 Width, int32 Height)
+	{
+		const uint64 Span = MakeSpanMask(Col, Width);
+		for (int32 r = Row; r < Row + Height; ++r)
+		{
+			RowMasks[r] &= ~Span;
+		}
+	}
+
+private:
+	using FRowFitArray = TArray<uint64, TInlineAllocator<64>>;
+
+	/** Per row: bit C set if columns [C, C + Width) are all free (false if the size cannot fit at all) */
+	bool BuildRowFits(int32 Width, int32 Height, FRowFitArray& OutRowFits) const
+	{
+		if (Width <= 0 || Height <= 0 || Width > Cols || Height > Rows)
+		{
+			return false;
+		}
+
+		OutRowFits.SetNumUninitialized(Rows);
+		for (int32 r = 0; r < Rows; ++r)
+		{
+			OutRowFits[r] = MakeRunMask(~RowMasks[r] & FullRowMask(), Width);
+		}
+		return true;
+	}
+
+	/** Columns where a rectangle of Height rows starting at Row fits */
+	static uint64 GetRectFits(const FRowFitArray& RowFits, int32 Row, int32 Height)
+	{
+		uint64 Fit = RowFits[Row];
+		for (int32 r = 1; r < Height && Fit; ++r)
+		{
+			Fit &= RowFits[Row + r];
+		}
+		return Fit;
+	}
+
+	bool IsInBounds(int32 Row, int32 Col, int32 Width, int32 Height) const
+	{
+		return Row >= 0 && Col >= 0 && Width > 0 && Height > 0 &&
+			Row + Height <= Rows && Col + Width <= Cols;
+	}
+
+	uint64 FullRowMask() const
+	{
+		return Cols >= MaxColumns ? ~uint64(0) : ((uint64(1) << Cols) - 1);
+	}
+
+	/** Bits [Col, Col + Width) set */
+	static uint64 MakeSpanMask(int32 Col, int32 Width)
+	{
+		const uint64 Bits = Width >= MaxColumns ? ~uint64(0) : ((uint64(1) << Width) - 1);
+		return Bits << Col;
+	}
+
+	/** Bit C set if FreeBits has Width consecutive set bits starting at C (shift-and doubling) */
+	static uint64 MakeRunMask(uint64 FreeBits, int32 Width)
+	{
+		uint64 Run = FreeBits;
+		int32 Length = 1;
+		while (Length < Width && Run)
+		{
+			const int32 Shift = FMath::Min(Length, Width - Length);
+			Run &= Run >> Shift;
+			Length += Shift;
+		}
+		return Run;
+	}
+
+	TArray<uint64> RowMasks;
+	int32 Rows = 0;
+	int32 Cols = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/PrimaryAssetId.h"
+#include "Data/ItemData.h"
+#include "Weapon/Interaction.h"
+
+/**
+ * Binary inventory/equipment save format versions (append only)
+ */
+enum class EInventorySaveVersion : uint8
+{
+	Initial = 1,
+
+	// -----<new versions can be added above this line>-----
+	VersionPlusOne,
+	Latest = VersionPlusOne - 1
+};
+
+/**
+ * Compact snapshot of an inventory + equipment, serialized with a plain FArchive
+ *
+ * Layout: magic, version, a table of unique item asset ids (each written once),
+ * then slots/equipment that reference the table by packed index.
+ * Small ints are written with SerializeIntPacked, durability is quantized to a byte.
+ * Pure data: building it and applying it happen on the game thread, (de)serializing can run on any thread.
+ */
+struct TPSTEMPLATE_API FInventorySaveData
+{
+	struct FSlotRecord
+	{
+		int32 AssetIndex = INDEX_NONE;
+		int32 GridRow = -1;
+		int32 GridCol = -1;
+		bool bRotated = false;
+		int32 Quantity = 1;
+		float Durability = 1.0f;
+	};
+
+	struct FEquipmentRecord
+	{
+		EEquipmentSlot Slot = EEquipmentSlot::None;
+		int32 AssetIndex = INDEX_NONE;
+		bool bHasAmmo = false;
+		FWeaponAmmoState Ammo;
+	};
+
+	/** Unique item assets referenced by the records below */
+	TArray<FPrimaryAssetId> Assets;
+
+	TArray<FSlotRecord> Slots;
+
+	TArray<FEquipmentRecord> Equipment;
+
+	/** Index of ItemData's primary asset id in Assets (added if new), INDEX_NONE if it has no valid id */
+	int32 FindOrAddAsset(const UItemData* ItemData);
+
+	/** Read or write the whole snapshot; returns false on a bad header or unsupported version */
+	bool Serialize(FArchive& Ar);
+
+	bool SaveToBytes(TArray<uint8>& OutBytes);
+
+	bool LoadFromBytes(const TArray<uint8>& Bytes);
+};
@@ -2,14 +2,39 @@
 
 #include "CoreMinimal.h"
 #include "Data/ItemData.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "InventoryTypes.generated.h"
 
+class UInventorySystem;
+
+/**
+ * Item properties the inventory needs on hot paths, copied from ItemData once when a slot is resolved
+ */
+struct FItemFootprint
+{
+	int32 GridWidth = 1;
+	int32 GridHeight = 1;
+	int32 MaxStackSize = 1;
+	bool bStackable = false;
+	float UnitWeight = 0.0f;
+
+	FItemFootprint() = default;
+
+	explicit FItemFootprint(const UItemData& Data)
+		: GridWidth(Data.GridWidth)
+		, GridHeight(Data.GridHeight)
+		, MaxStackSize(Data.MaxStackSize)
+		, bStackable(Data.bStackable)
+		, UnitWeight(Data.Weight)
+	{}
+};
+
 /**
  * Represents a single item slot in the inventory
  * Holds reference to ItemData and instance-specific properties
  */
 USTRUCT(BlueprintType)
-struct FItemSlot
+struct FItemSlot : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
@@ -33,6 +58,10 @@ struct FItemSlot
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item|Grid")
 	int32 GridCol = -1;
 
+	/** Placed rotated 90 degrees (GridWidth/GridHeight swapped) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item|Grid")
+	bool bRotated = false;
+
 	/** Number of items in this stack (must respect ItemData->MaxStackSize) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item", meta = (ClampMin = "0"))
 	int32 Quantity = 1;
@@ -45,6 +74,17 @@ struct FItemSlot
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item", meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float Durability = 1.0f;
 
+	//==============================================================================
+	// Resolved Data (cached, not serialized)
+	//==============================================================================
+
+	/** ItemData resolved once (see Resolve); hot paths use this instead of the soft pointer */
+	UPROPERTY(Transient, NotReplicated)
+	UItemData* ResolvedItemData = nullptr;
+
+	/** Grid size, weight and stack limits captured from ResolvedItemData */
+	FItemFootprint Footprint;
+
 	//==============================================================================
 	// Constructor & Operators
 	//==============================================================================
@@ -53,6 +93,7 @@ struct FItemSlot
 		: ItemData(nullptr)
 		, GridRow(-1)
 		, GridCol(-1)
+		, bRotated(false)
 		, Quantity(1)
 		, InstanceId(FGuid::NewGuid())
 		, Durability(1.0f)
@@ -62,10 +103,17 @@ struct FItemSlot
 		: ItemData(InItemData)
 		, GridRow(-1)
 		, GridCol(-1)
+		, bRotated(false)
 		, Quantity(InQuantity)
 		, InstanceId(FGuid::NewGuid())
 		, Durability(1.0f)
-	{}
+	{
+		// Already in memory (the usual case when adding from a loaded asset): resolve without loading
+		if (UItemData* Loaded = ItemData.Get())
+		{
+			Resolve(Loaded);
+		}
+	}
 
 	bool operator==(const FItemSlot& Other) const
 	{
@@ -93,55 +141,75 @@ struct FItemSlot
 		return ItemData.IsNull() || Quantity <= 0;
 	}
 
-	/** Get the loaded ItemData (loads if not already loaded) */
+	/** Check if ItemData has been resolved and the footprint captured */
+	bool IsResolved() const
+	{
+		return ResolvedItemData != nullptr;
+	}
+
+	/** Cache the loaded ItemData and capture its footprint */
+	void Resolve(UItemData* Data)
+	{
+		ResolvedItemData = Data;
+		Footprint = Data ? FItemFootprint(*Data) : FItemFootprint();
+	}
+
+	/**
+	 * Resolve from the soft pointer. Without bAllowBlockingLoad a slot whose asset is not in memory stays unresolved
+	 * (clients: UInventorySystem::PreloadItemData loads it and resolves again)
+	 */
+	bool ResolveItemData(bool bAllowBlockingLoad = true)
+	{
+		if (!IsResolved() && !ItemData.IsNull())
+		{
+			UItemData* Data = ItemData.Get();
+			if (!Data && bAllowBlockingLoad)
+			{
+				Data = ItemData.LoadSynchronous();
+			}
+			Resolve(Data);
+		}
+		return IsResolved();
+	}
+
+	/** Get the ItemData (cached pointer if resolved, else the asset if already in memory; never loads) */
 	UItemData* GetItemData() const
 	{
-		return ItemData.LoadSynchronous();
+		return ResolvedItemData ? ResolvedItemData : ItemData.Get();
 	}
 
 	/** Get total weight of items in this slot */
 	float GetTotalWeight() const
 	{
-		if (UItemData* Data = GetItemData())
-		{
-			return Data->GetTotalWeight(Quantity);
-		}
-		return 0.0f;
+		return Footprint.UnitWeight * FMath::Max(0, Quantity);
 	}
 
 	/** Check if this slot can stack with another slot */
 	bool CanStackWith(const FItemSlot& Other) const
 	{
-		if (ItemData != Other.ItemData || ItemData.IsNull())
+		if (!IsResolved() || ResolvedItemData != Other.ResolvedItemData)
 		{
 			return false;
 		}
 
-		UItemData* Data = GetItemData();
-		if (!Data || !Data->bStackable)
+		if (!Footprint.bStackable)
 		{
 			return false;
 		}
 
 		// Can stack if same item and total quantity doesn't exceed max stack size
-		return (Quantity + Other.Quantity) <= Data->MaxStackSize;
+		return (Quantity + Other.Quantity) <= Footprint.MaxStackSize;
 	}
 
 	/** Add quantity to this slot (returns overflow amount if exceeds max stack) */
 	int32 AddQuantity(int32 Amount)
 	{
-		if (Amount <= 0 || ItemData.IsNull())
+		if (Amount <= 0 || !IsResolved())
 		{
 			return Amount;
 		}
 
-		UItemData* Data = GetItemData();
-		if (!Data)
-		{
-			return Amount;
-		}
-
-		int32 MaxAdd = Data->bStackable ? (Data->MaxStackSize - Quantity) : 0;
+		int32 MaxAdd = Footprint.bStackable ? (Footprint.MaxStackSize - Quantity) : 0;
 		int32 ActualAdd = FMath::Min(Amount, MaxAdd);
 
 		Quantity += ActualAdd;
@@ -160,8 +228,10 @@ struct FItemSlot
 	void Clear()
 	{
 		ItemData = nullptr;
+		Resolve(nullptr);
 		GridRow = -1;
 		GridCol = -1;
+		bRotated = false;
 		Quantity = 0;
 		Durability = 1.0f;
 	}
@@ -170,6 +240,18 @@ struct FItemSlot
 	// Grid Helper Functions
 	//==============================================================================
 
+	/** Width in grid cells as placed (accounts for rotation) */
+	int32 GetGridWidth() const
+	{
+		return bRotated ? Footprint.GridHeight : Footprint.GridWidth;
+	}
+
+	/** Height in grid cells as placed (accounts for rotation) */
+	int32 GetGridHeight() const
+	{
+		return bRotated ? Footprint.GridWidth : Footprint.GridHeight;
+	}
+
 	/** Check if this item is placed in the grid */
 	bool IsPlacedInGrid() const
 	{
@@ -179,20 +261,14 @@ struct FItemSlot
 	/** Check if this item occupies a specific grid cell */
 	bool OccupiesCell(int32 Row, int32 Col) const
 	{
-		if (!IsPlacedInGrid())
-		{
-			return false;
-		}
-
-		UItemData* Data = GetItemData();
-		if (!Data)
+		if (!IsPlacedInGrid() || !IsResolved())
 		{
 			return false;
 		}
 
 		// Check if (Row, Col) is within the item's bounding box
-		return Row >= GridRow && Row < (GridRow + Data->GridHeight) &&
-		       Col >= GridCol && Col < (GridCol + Data->GridWidth);
+		return Row >= GridRow && Row < (GridRow + GetGridHeight()) &&
+		       Col >= GridCol && Col < (GridCol + GetGridWidth());
 	}
 
 	/** Get all grid cells occupied by this item */
@@ -200,20 +276,15 @@ struct FItemSlot
 	{
 		TArray<FIntPoint> Cells;
 
-		if (!IsPlacedInGrid())
+		if (!IsPlacedInGrid() || !IsResolved())
 		{
 			return Cells;
 		}
 
-		UItemData* Data = GetItemData();
-		if (!Data)
+		Cells.Reserve(GetGridWidth() * GetGridHeight());
+		for (int32 Row = GridRow; Row < GridRow + GetGridHeight(); ++Row)
 		{
-			return Cells;
-		}
-
-		for (int32 Row = GridRow; Row < GridRow + Data->GridHeight; ++Row)
-		{
-			for (int32 Col = GridCol; Col < GridCol + Data->GridWidth; ++Col)
+			for (int32 Col = GridCol; Col < GridCol + GetGridWidth(); ++Col)
 			{
 				Cells.Add(FIntPoint(Col, Row));
 			}
@@ -221,4 +292,80 @@ struct FItemSlot
 
 		return Cells;
 	}
-};
\ No newline at end of file
+};
+/**
+ * Replicated item list for UInventorySystem
+ * Fast-array delta serialization: only slots marked dirty (or added/removed) are sent
+ */
+USTRUCT()
+struct FInventoryItemArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FItemSlot> Items;
+
+	/** Owning inventory, rebuilt on clients after each replicated update */
+	UPROPERTY(NotReplicated)
+	UInventorySystem* Owner = nullptr;
+
+	/** Client: called once after a batch of adds/changes/removes has been applied */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FItemSlot, FInventoryItemArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryItemArray> : public TStructOpsTypeTraitsBase2<FInventoryItemArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * One entry of a batched UInventorySystem::AddItems call
+ */
+USTRUCT(BlueprintType)
+struct FItemAddRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
+	UItemData* ItemData = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item", meta = (ClampMin = "1"))
+	int32 Quantity = 1;
+
+	FItemAddRequest() = default;
+
+	FItemAddRequest(UItemData* InItemData, int32 InQuantity = 1)
+		: ItemData(InItemData)
+		, Quantity(InQuantity)
+	{}
+};
+
+/**
+ * Outcome of a batched UInventorySystem::AddItems call
+ */
+USTRUCT(BlueprintType)
+struct FItemAddBatchResult
+{
+	GENERATED_BODY()
+
+	/** Requests that were fully added (stacked and/or placed) */
+	UPROPERTY(BlueprintReadOnly, Category = "Item")
+	int32 NumAdded = 0;
+
+	/** Indices of requests that could not be added (invalid, over weight, or no room) */
+	UPROPERTY(BlueprintReadOnly, Category = "Item")
+	TArray<int32> FailedRequests;
+
+	/** False if nothing was applied (all-or-nothing batch with a failure, or nothing to add) */
+	UPROPERTY(BlueprintReadOnly, Category = "Item")
+	bool bCommitted = false;
+};
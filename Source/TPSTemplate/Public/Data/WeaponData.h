@@ -7,6 +7,7 @@
 #include "WeaponData.generated.h"
 
 class UNiagaraSystem;
+class UCurveVector;
 class AMasterWeapon;
 class UW_DynamicWeaponHUD;
 
@@ -25,6 +26,21 @@ enum class EFireMode : uint8
 	Burst       UMETA(DisplayName = "Burst")
 };
 
+UENUM(BlueprintType)
+enum class EBallisticsModel : uint8
+{
+	Hitscan     UMETA(DisplayName = "Hitscan"),
+	Projectile  UMETA(DisplayName = "Simulated Projectile")
+};
+
+UENUM(BlueprintType)
+enum class EMuzzleFlashPoolMode : uint8
+{
+	None        UMETA(DisplayName = "Spawn Per Shot"),
+	Persistent  UMETA(DisplayName = "Persistent Component"),
+	WorldPool   UMETA(DisplayName = "World Pool (AutoRelease)")
+};
+
 /**
  * Weapon-specific data that extends the base ItemData
  */
@@ -36,6 +52,9 @@ class TPSTEMPLATE_API UWeaponData : public UItemData
 public:
 	UWeaponData();
 
+	/** Shots one trigger press may fire: 1 for semi-auto, BurstShotCount for burst, 0 (no limit) for full-auto */
+	int32 GetShotsPerPress() const;
+
 	// Weapon Details
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon Details")
 	EWeaponType WeaponType;
@@ -43,9 +62,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fire Mode Data")
 	EFireMode FireMode;
 
+	/** Pellets per shot (shotguns); every pellet of a shot is traced together */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fire Mode Data")
 	int32 BurstAmount;
 
+	/** Shots fired per trigger press in Burst fire mode */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fire Mode Data", meta = (ClampMin = "1", EditCondition = "FireMode == EFireMode::Burst"))
+	int32 BurstShotCount;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fire Mode Data")
 	float FireRate;
 
@@ -53,12 +77,40 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
 	float BulletSpread;
 
+	/** Seed of the weapon's spread sequence (0 = derived from this asset's path, identical on every machine) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
+	int32 SpreadSeed = 0;
+
+	/** Optional recoil pattern: X/Y offset (same units as spread) by consecutive shot index */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
+	UCurveVector* RecoilPattern = nullptr;
+
+	/** Pause between shots after which the recoil pattern starts over */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "0.0"))
+	float RecoilResetTime = 0.3f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
 	float Damage;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
 	float MaxRange;
 
+	/** Hitscan resolves instantly; Projectile is simulated by UBallisticsSubsystem (drop, drag, travel time) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics")
+	EBallisticsModel BallisticsModel = EBallisticsModel::Hitscan;
+
+	/** Initial projectile speed (cm/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "1.0", EditCondition = "BallisticsModel == EBallisticsModel::Projectile"))
+	float MuzzleVelocity = 40000.0f;
+
+	/** Quadratic drag: deceleration = DragCoefficient * speed^2 (1/cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "0.0", EditCondition = "BallisticsModel == EBallisticsModel::Projectile"))
+	float DragCoefficient = 0.000002f;
+
+	/** Multiplier on world gravity for bullet drop */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "0.0", EditCondition = "BallisticsModel == EBallisticsModel::Projectile"))
+	float GravityScale = 1.0f;
+
 	// UI
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
 	UTexture2D* WeaponUITexture;
@@ -107,9 +159,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX")
 	UNiagaraSystem* MuzzleFlashVFX;
 
+	/**
+	 * How the muzzle flash component is obtained per shot. Spawn Per Shot is the original behaviour; Persistent keeps one
+	 * component per weapon and restarts it (the previous flash is cut short), so assets opt in
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX")
+	EMuzzleFlashPoolMode MuzzleFlashPoolMode = EMuzzleFlashPoolMode::None;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX")
 	TSubclassOf<AActor> BulletTraceClass;
 
+	/** Tracers created in the world's actor pool when the weapon spawns (covers a burst without spawning) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX", meta = (ClampMin = "0"))
+	int32 TracerPrewarmCount = 8;
+
+	/** Seconds before a tracer returns to the pool (0 = the tracer class's InitialLifeSpan) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX", meta = (ClampMin = "0.0"))
+	float TracerLifetime = 0.0f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VFX")
 	TSubclassOf<UUserWidget> HitMarkerUI;
 
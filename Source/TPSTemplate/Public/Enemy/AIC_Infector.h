@@ -7,11 +7,36 @@
 #include "AIC_Infector.generated.h"
 
 /**
- * 
+ * Infector swarm controller: moves towards actors follow the target's shared flow field (UFlowFieldSubsystem)
+ * instead of running a navmesh path query per agent; anything the field cannot serve uses regular pathfinding.
  */
 UCLASS()
 class TPSTEMPLATE_API AAIC_Infector : public ATPSTemplate_AIController
 {
 	GENERATED_BODY()
-	
+
+public:
+	virtual FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr) override;
+
+	virtual void OnUnPossess() override;
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI|Navigation")
+	bool bUseFlowField = true;
+
+	/** Seconds between checks that the flow path still matches the goal's field */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI|Navigation", meta = (ClampMin = "0.05"))
+	float FlowPathRefreshInterval = 0.25f;
+
+private:
+	/** Re-walk the goal's field into the active path once the field rebuilt or the goal left its cell */
+	void RefreshFlowPath();
+
+	void StopFlowPathRefresh();
+
+	FNavPathSharedPtr FlowPath;
+	FAIMoveRequest FlowMoveRequest;
+	TWeakObjectPtr<const AActor> FlowGoal;
+	uint32 FlowFieldVersion = 0;
+	FTimerHandle FlowPathRefreshTimer;
 };
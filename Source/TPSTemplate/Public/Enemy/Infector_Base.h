@@ -13,5 +13,7 @@ UCLASS()
 class TPSTEMPLATE_API AInfector_Base : public ATPSTemplate_Enemy_Base
 {
 	GENERATED_BODY()
-	
+
+protected:
+	AInfector_Base();
 };
@@ -29,6 +29,47 @@ enum class EAIState : uint8
 	Investigating	UMETA(DisplayName = "Investigating"),
 	Seeking			UMETA(DisplayName = "Seeking")
 };
+
+/** Sight / hearing / damage stimuli of one perceived actor, read once per perception update */
+struct FAIPerceptionSnapshot
+{
+	/** Compared only - resolved on the game thread */
+	TWeakObjectPtr<AActor> Actor;
+	FVector ActorLocation = FVector::ZeroVector;
+	float Distance = 0.f;
+
+	/** Invalid (IsValid() == false) when the sense never reported this actor */
+	FAIStimulus Sight;
+	FAIStimulus Hearing;
+	FAIStimulus Damage;
+};
+
+/** Reaction calls produced by ATPSTemplate_AIController::DecidePerception, replayed in order on the game thread */
+enum class EAIPerceptionAction : uint8
+{
+	SensedSight,
+	LostSight,
+	SensedHearing,
+	Investigate,
+	SetLastKnownLocation
+};
+
+struct FAIPerceptionAction
+{
+	EAIPerceptionAction Type = EAIPerceptionAction::SensedSight;
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+};
+
+/** One controller's perception update: game-thread copies in, actions out */
+struct FAIPerceptionBatch
+{
+	TArray<FAIPerceptionSnapshot, TInlineAllocator<2>> Snapshots;
+	EAIState State = EAIState::Passive;
+	bool bHasBlackboard = false;
+
+	TArray<FAIPerceptionAction, TInlineAllocator<4>> Actions;
+};
 /**
  * 
  */
@@ -46,8 +87,20 @@ public:
 	void SetStateAsAttacking(AActor* ToSetAttackTarget, bool bUseLastKnownAttackTarget);
 
 	void SetStateAsInvestigating(FVector Location);
+
+	/** True while engaging an attack target (UEnemySignificanceSubsystem keeps these enemies' sight on) */
+	bool IsAttacking() const { return AIState == EAIState::Attacking; }
 	
 	bool CanSenseActor(AActor* Actor, ESenseType SenseType, FAIStimulus& StimulusRef);
+
+	/** Snapshot the perception of every player in UpdateActors, together with the state the decisions start from */
+	void BuildPerceptionBatch(const TArray<AActor*>& UpdateActors, FAIPerceptionBatch& Batch) const;
+
+	/** Turn a batch's snapshots into reaction actions; touches no UObject, safe on worker threads (UAIDirectorSubsystem) */
+	static void DecidePerception(FAIPerceptionBatch& Batch);
+
+	/** Replay the decided actions - blackboard writes and timers (game thread) */
+	void ApplyPerceptionBatch(const FAIPerceptionBatch& Batch);
 	
 	void HandleSensedSight(AActor* Actor);
 
@@ -63,6 +116,13 @@ public:
 	void OnPerceptionUpdated(const TArray<AActor*>& UpdateActors);
 	
 protected:
+	/** Stimulus of SenseID from an actor's perception info, without copying the info */
+	const FAIStimulus* FindStimulus(const AActor* Actor, FAISenseID SenseID) const;
+
+	FAISenseID SightSenseID;
+	FAISenseID HearingSenseID;
+	FAISenseID DamageSenseID;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI|Perception")
 	UAIPerceptionComponent* AIPerception;
 
@@ -17,4 +17,5 @@ class TPSTEMPLATE_API ATPSTemplate_Enemy_Base : public ATPSTemplateCharacter
 protected:
 	ATPSTemplate_Enemy_Base();
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
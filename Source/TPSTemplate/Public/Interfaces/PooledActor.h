@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PooledActor.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, Blueprintable)
+class UPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Optional hooks for actors recycled by UActorPoolSubsystem
+ * Implement to reset per-use state (timelines, trails, materials) that a fresh spawn would have had
+ */
+class TPSTEMPLATE_API IPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Called after the actor is moved into place and made visible again */
+	UFUNCTION(BlueprintNativeEvent, Category = "Pool")
+	void OnAcquiredFromPool();
+
+	/** Called right before the actor is hidden and returned to the pool */
+	UFUNCTION(BlueprintNativeEvent, Category = "Pool")
+	void OnReleasedToPool();
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Enemy/TPSTemplate_AIController.h"
+#include "AIDirectorSubsystem.generated.h"
+
+/**
+ * Batches the perception reactions of every AI controller
+ *
+ * Controllers snapshot their perception when it updates (game thread) and queue it here. Once per frame the director
+ * runs all state decisions with ParallelFor - they only read the snapshots - and then replays each controller's
+ * resulting blackboard writes and timers on the game thread, in queue order.
+ */
+UCLASS()
+class TPSTEMPLATE_API UAIDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Snapshot Controller's perception of UpdateActors for this frame's batch */
+	void QueuePerception(ATPSTemplate_AIController* Controller, const TArray<AActor*>& UpdateActors);
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FQueuedPerception
+	{
+		TWeakObjectPtr<ATPSTemplate_AIController> Controller;
+		FAIPerceptionBatch Batch;
+	};
+
+	/** Below this many controllers the decisions run inline; task dispatch would cost more than it saves */
+	static constexpr int32 MinParallelBatches = 16;
+
+	TArray<FQueuedPerception> Queued;
+
+	/** Controller -> index into Queued, so a repeat update in the same frame finds its entry without a scan */
+	TMap<TObjectKey<ATPSTemplate_AIController>, int32> QueuedIndexByController;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorPoolSubsystem.generated.h"
+
+/**
+ * Per-world pool of short-lived actors (bullet tracers), keyed by class
+ *
+ * Acquire() reuses a hidden instance when one is free and only spawns on a miss; instances with a lifetime
+ * are returned automatically when it expires, so callers can fire-and-forget like SpawnActor.
+ * Pooled actors are hidden, collision- and tick-disabled while free; implement IPooledActor to reset extra state.
+ */
+UCLASS()
+class TPSTEMPLATE_API UActorPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//==============================================================================
+	// Pool API
+	//==============================================================================
+
+	/** Make sure at least Count free instances of ActorClass exist */
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/**
+	 * Take an instance of ActorClass (spawning one if the pool is empty) and place it at Transform
+	 * @param Lifetime - seconds until it is released automatically; <= 0 uses the class InitialLifeSpan,
+	 *                   and if that is also 0 the caller must Release() it
+	 */
+	AActor* Acquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, float Lifetime = 0.0f, AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	/** Return an acquired actor to its pool (destroyed instead if the pool is already full) */
+	void Release(AActor* Actor);
+
+	int32 GetNumFree(TSubclassOf<AActor> ActorClass) const;
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Free instances kept per class; releases beyond this destroy the actor */
+	static constexpr int32 MaxFreePerClass = 64;
+
+	/** Seconds between sweeps for acquired actors destroyed outside the pool */
+	static constexpr double StaleSweepInterval = 1.0;
+
+	struct FActiveEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		double ReleaseTime = 0.0;
+
+		/** Acquire serial, so an entry left over from an earlier use does not release a reused actor */
+		uint32 Serial = 0;
+
+		bool operator<(const FActiveEntry& Other) const { return ReleaseTime < Other.ReleaseTime; }
+	};
+
+	AActor* SpawnPooledActor(UClass* ActorClass);
+
+	void ActivateActor(AActor* Actor, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+	void DeactivateActor(AActor* Actor);
+
+	/** Free instances per class (weak: anything destroyed externally is skipped on the next acquire) */
+	TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>> FreeActors;
+
+	/** Acquired actors with a lifetime, as a min-heap on ReleaseTime */
+	TArray<FActiveEntry> TimedActors;
+
+	/** Currently acquired actors -> serial of their current use */
+	TMap<TObjectKey<AActor>, uint32> ActiveSerials;
+
+	uint32 NextSerial = 0;
+
+	double NextStaleSweepTime = 0.0;
+
+	/** Running average cost of a real SpawnActor, used to estimate the time saved by reuse */
+	double AverageSpawnMs = 0.0;
+	int32 NumSpawns = 0;
+	int32 NumReuses = 0;
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "BallisticsSubsystem.generated.h"
+
+class AMasterWeapon;
+
+/**
+ * Simulates projectile bullets (gravity drop, quadratic drag, travel time) for weapons using EBallisticsModel::Projectile
+ *
+ * State is kept as a structure of arrays so the integration step is a flat loop over float arrays, split across
+ * workers with ParallelFor. Each step's travel segment is queued as an async line trace, and the batch is resolved
+ * the next frame (a segment whose result is gone is traced again synchronously); impacts go back to the firing
+ * weapon's regular hit path.
+ *
+ * tps.Weapon.BallisticsBenchmark [Count] [Steps] times the integration step for Count projectiles, parallel and serial.
+ */
+UCLASS()
+class TPSTEMPLATE_API UBallisticsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Launch a projectile along Direction using the weapon's ballistics settings */
+	void FireProjectile(AMasterWeapon* Weapon, const FVector& Origin, const FVector& Direction);
+
+	int32 GetNumProjectiles() const { return PosX.Num(); }
+
+	/** Time NumSteps integration steps over Count synthetic projectiles (needs no projectiles in flight) */
+	void RunBenchmark(int32 Count, int32 NumSteps);
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Projectiles integrated per ParallelFor task */
+	static constexpr int32 IntegrationChunkSize = 1024;
+
+	struct FPendingSegment
+	{
+		FTraceHandle Handle;
+		int32 ProjectileIndex = INDEX_NONE;
+	};
+
+	struct FImpact
+	{
+		TWeakObjectPtr<AMasterWeapon> Weapon;
+		FHitResult Hit;
+		FVector Origin = FVector::ZeroVector;
+	};
+
+	/** Read last frame's segment traces and flag projectiles that hit something */
+	void ResolveSegments();
+
+	/** Segment trace params for a weapon's projectiles: the weapon and its owner are ignored */
+	static FCollisionQueryParams MakeSegmentParams(AMasterWeapon* Weapon);
+
+	/** Swap-remove dead or spent projectiles from every array */
+	void Compact();
+
+	/** Advance all projectiles by DeltaTime */
+	void Integrate(float DeltaTime, bool bParallel = true);
+
+	void AddProjectile(AMasterWeapon* Weapon, const FVector& Origin, const FVector& Velocity, float DragCoefficient, float Gravity, float Range);
+
+	/** Queue this step's travel segments as async traces */
+	void QueueSegments();
+
+	void RemoveAtSwap(int32 Index);
+
+	//==============================================================================
+	// Projectile state (one entry per projectile in each array)
+	//==============================================================================
+
+	// Hot: touched by the integration step
+	TArray<float> PosX, PosY, PosZ;
+	TArray<float> VelX, VelY, VelZ;
+	TArray<float> PrevX, PrevY, PrevZ;
+	TArray<float> Drag;
+	TArray<float> GravityZ;
+	TArray<float> RemainingRange;
+
+	// Cold: only read when queuing traces or resolving hits
+	TArray<TWeakObjectPtr<AMasterWeapon>> Weapons;
+	TArray<FVector> Origins;
+	TArray<uint8> bAlive;
+
+	/** Segment traces queued last step */
+	TArray<FPendingSegment> PendingSegments;
+
+	/** Impacts found this frame, dispatched once the arrays are consistent again */
+	TArray<FImpact> PendingImpacts;
+};
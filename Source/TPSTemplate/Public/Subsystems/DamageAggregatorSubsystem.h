@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/HitResult.h"
+#include "DamageAggregatorSubsystem.generated.h"
+
+class AMasterWeapon;
+
+/**
+ * Collects the bullet hits of a frame and applies them in one pass after all actors and subsystems ticked
+ *
+ * Hits from the same weapon on the same victim bone are merged into a single TakeDamage call with the summed damage,
+ * each victim gets one IsDead check, and each weapon plays one hit marker / kill sound per frame.
+ * A shotgun blast landing 8 pellets on a chest is one damage event instead of eight.
+ */
+UCLASS()
+class TPSTEMPLATE_API UDamageAggregatorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Queue Damage from Weapon for HitResult; applied when the frame's actors finished ticking */
+	void QueueHit(AMasterWeapon* Weapon, const FHitResult& HitResult, float Damage);
+
+	/** Apply every queued hit now */
+	void Flush();
+
+	//==============================================================================
+	// UWorldSubsystem
+	//==============================================================================
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingHit
+	{
+		TWeakObjectPtr<AMasterWeapon> Weapon;
+
+		/** First hit of the merged group; its bone and impact drive the damage event */
+		FHitResult Hit;
+		float Damage = 0.0f;
+	};
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** One entry per (weapon, victim, bone) - a frame holds a handful, so lookups stay linear */
+	TArray<FPendingHit> PendingHits;
+
+	FDelegateHandle PostActorTickHandle;
+};
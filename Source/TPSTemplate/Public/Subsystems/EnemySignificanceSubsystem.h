@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+class ATPSTemplate_Enemy_Base;
+
+/** How much an enemy matters to the local player; lower buckets update less often */
+UENUM(BlueprintType)
+enum class EEnemySignificance : uint8
+{
+	Critical	UMETA(DisplayName = "Critical"),
+	High		UMETA(DisplayName = "High"),
+	Medium		UMETA(DisplayName = "Medium"),
+	Dormant		UMETA(DisplayName = "Dormant")
+};
+
+/**
+ * Throttles enemy updates by significance so a horde costs what the player can actually notice
+ *
+ * Enemies are bucketed by distance to the local camera (one bucket lower when not rendered recently, except while
+ * attacking: an engaged enemy is never throttled below Medium, so it keeps its sight). Each bucket sets
+ * the tick interval of the actor and its movement, and the animation frame skip of the mesh's update rate
+ * optimization (skipped poses are interpolated); Dormant enemies also stop running sight queries. Re-bucketing is
+ * round-robin: at most tps.AI.SignificanceUpdatesPerFrame enemies are evaluated per frame, so the cost stays flat
+ * however many enemies are alive. tps.AI.SignificanceEnabled 0 keeps every enemy at full rate.
+ *
+ * tps.AI.Benchmark [Count] [Frames] [EnemyClass] spawns Count enemies around the player and logs the average frame
+ * time with throttling off, then on; the enemies are destroyed afterwards. Pass the infector Blueprint's class path (e.g. /Game/.../BP_Infector.BP_Infector_C) so the enemies have a
+ * mesh and animation to throttle; run it with -nullrhi for a headless game-thread measurement.
+ */
+UCLASS()
+class TPSTEMPLATE_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterEnemy(ATPSTemplate_Enemy_Base* Enemy);
+	void UnregisterEnemy(ATPSTemplate_Enemy_Base* Enemy);
+
+	/**
+	 * Spawn Count enemies of EnemyClass around the player and log the average frame time over NumFrames frames
+	 * unthrottled (baseline), then NumFrames frames throttled; the enemies are destroyed when it finishes
+	 */
+	void RunBenchmark(int32 Count, int32 NumFrames, TSubclassOf<ATPSTemplate_Enemy_Base> EnemyClass);
+
+	int32 GetNumEnemies() const { return Enemies.Num(); }
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FTrackedEnemy
+	{
+		TWeakObjectPtr<ATPSTemplate_Enemy_Base> Enemy;
+		EEnemySignificance Significance = EEnemySignificance::Critical;
+	};
+
+	EEnemySignificance EvaluateSignificance(const ATPSTemplate_Enemy_Base* Enemy, const FVector& ViewLocation) const;
+
+	/** Push the bucket's update rates to the enemy, its components and its controller */
+	static void ApplySignificance(ATPSTemplate_Enemy_Base* Enemy, EEnemySignificance Significance);
+
+	void RemoveEnemyAt(int32 Index);
+
+	/** Move Entry to NewSignificance: bucket stats and the enemy's update rates */
+	void SetSignificance(FTrackedEnemy& Entry, ATPSTemplate_Enemy_Base* Enemy, EEnemySignificance NewSignificance);
+
+	/** Re-bucket every enemy now instead of over the next round-robin passes (throttling switched on or off) */
+	void ReevaluateAll();
+
+	/** Accumulate one benchmark frame; SignificanceTime is what this frame's significance pass cost */
+	void TickBenchmark(double SignificanceTime);
+
+	TArray<FTrackedEnemy> Enemies;
+
+	/** Next enemy the round-robin evaluates */
+	int32 Cursor = 0;
+
+	/** Whether the last pass ran with throttling on (a change re-buckets everything) */
+	bool bThrottlingApplied = true;
+
+	/** Frames to measure per phase; 0 when no benchmark runs */
+	int32 BenchmarkTargetFrames = 0;
+	int32 BenchmarkWarmupRemaining = 0;
+	int32 BenchmarkFrames = 0;
+	/** False during the unthrottled baseline phase */
+	bool bBenchmarkThrottled = false;
+	/** tps.AI.SignificanceEnabled before the benchmark, restored when it finishes */
+	bool bBenchmarkSavedEnabled = true;
+	double BenchmarkLastTickTime = 0.0;
+	double BenchmarkFrameTime = 0.0;
+	double BenchmarkSignificanceTime = 0.0;
+	double BenchmarkBaselineFrameTime = 0.0;
+	double BenchmarkBaselineSignificanceTime = 0.0;
+	/** Enemies the benchmark spawned, destroyed when it finishes */
+	TArray<TWeakObjectPtr<ATPSTemplate_Enemy_Base>> BenchmarkEnemies;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Shared target-centred distance fields for swarms chasing one actor
+ *
+ * A field is a GridSize x GridSize grid of CellSize cells around the target. Cell walkability comes from projecting
+ * onto the navmesh (cached per world cell until the navmesh rebuilds), and one Dijkstra pass from the target gives
+ * every cell its distance and the next cell towards the target. The field is rebuilt only once the target has moved
+ * a cell; between rebuilds any number of agents get their path by walking the field, with no navmesh query.
+ *
+ * The field is 2D (one walkable height per cell), so multi-storey areas fall back to regular pathfinding.
+ * tps.AI.FlowFieldBenchmark [Agents] compares it against per-agent path queries.
+ */
+UCLASS()
+class TPSTEMPLATE_API UFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Path from From to Target along Target's flow field (built or refreshed as needed)
+	 * Returns false when From is outside the field or cannot reach the target - use regular pathfinding then.
+	 */
+	bool FindPathToTarget(const AActor* Target, const FVector& From, TArray<FVector>& OutPathPoints, uint32* OutFieldVersion = nullptr);
+
+	/** True once a path from field FieldVersion is out of date: the field was rebuilt or dropped, or Target left its cell */
+	bool IsPathStale(const AActor* Target, uint32 FieldVersion) const;
+
+	/** Time path queries against flow-field paths for NumAgents random start points around the local player */
+	void RunBenchmark(int32 NumAgents);
+
+	//==============================================================================
+	// UWorldSubsystem
+	//==============================================================================
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FFlowField
+	{
+		/** World cell of grid index (0, 0) */
+		FIntPoint Origin = FIntPoint::ZeroValue;
+		FVector TargetLocation = FVector::ZeroVector;
+		double LastUsedTime = 0.0;
+
+		/** Unique per build, so paths taken from an older build can tell */
+		uint32 Version = 0;
+
+		/** Target cell height when the target is off the navmesh; only this field treats the cell as walkable */
+		float TargetCellHeight = 0.f;
+		bool bTargetCellOverride = false;
+
+		/** Per grid cell: path cost to the target (MAX_flt when unreachable) and the next cell on the way (INDEX_NONE at the target) */
+		TArray<float> Distance;
+		TArray<int32> Next;
+	};
+
+	static constexpr int32 GridSize = 128;
+	static constexpr float CellSize = 100.f;
+
+	/** Taller steps between neighbouring cells are treated as walls */
+	static constexpr float MaxStepHeight = 60.f;
+
+	/** Fields nobody sampled for this long are dropped */
+	static constexpr double FieldLifetime = 5.0;
+
+	const FFlowField* GetField(const AActor* Target);
+	void BuildField(FFlowField& Field, const FVector& TargetLocation);
+
+	/** Navmesh height of a world cell, or nullptr when it is not walkable (cached) */
+	const float* GetCellHeight(const FIntPoint& WorldCell, float ReferenceZ);
+
+	/** GetCellHeight with the field's own target cell override applied */
+	const float* GetFieldCellHeight(const FFlowField& Field, const FIntPoint& WorldCell, float ReferenceZ);
+
+	FIntPoint ToWorldCell(const FVector& Location) const;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	TMap<TWeakObjectPtr<const AActor>, FFlowField> Fields;
+
+	/** World cell -> navmesh height; unwalkable cells hold UnwalkableHeight */
+	TMap<FIntPoint, float> CellHeights;
+
+	uint32 NextFieldVersion = 1;
+};
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitReactionSubsystem.generated.h"
+
+class UHurtbox;
+
+/** What RequestReaction decided for a hit */
+enum class EHitReactionRequest : uint8
+{
+	/** A new body started simulating */
+	Started,
+	/** The bone was already reacting; its recovery got extended */
+	Merged,
+	/** Out of LOD range - play no physical reaction */
+	Skipped
+};
+
+/**
+ * Budget and merge rules for active hit reactions, kept apart from the world so they can be tested on their own
+ * (UHitReactionSubsystem adds the distance LOD and ends the bodies this evicts)
+ */
+struct FHitReactionBudget
+{
+	struct FActiveReaction
+	{
+		TWeakObjectPtr<UHurtbox> Hurtbox;
+		FName BoneName;
+		double StartTime = 0.0;
+		double ExpireTime = 0.0;
+	};
+
+	/**
+	 * Extend the running reaction of BoneName on Hurtbox, if any (returns false when there is none)
+	 * It lasts Duration from Now but never less than it already had, and at most MaxDuration after it started.
+	 */
+	bool Merge(const UHurtbox* Hurtbox, FName BoneName, double Now, float Duration, float MaxDuration);
+
+	/** Reaction to end before a new one fits under MaxBodies (the one closest to recovering), or INDEX_NONE */
+	int32 FindEviction(int32 MaxBodies) const;
+
+	/** Start tracking a new reaction lasting Duration from Now */
+	void Add(UHurtbox* Hurtbox, FName BoneName, double Now, float Duration);
+
+	TArray<FActiveReaction> Reactions;
+};
+
+/**
+ * Owns every physical hit reaction in the world
+ *
+ * Hurtboxes ask here before simulating a bone. Several bones per character can react at once, a hit on a bone that is
+ * already simulating extends it instead of restarting it, and the number of simulated bodies across all characters
+ * is capped by tps.HitReaction.MaxBodies (the reaction closest to recovery is ended early to make room).
+ * Hits farther than tps.HitReaction.MaxDistance from the local camera, or on meshes not rendered recently, are skipped.
+ */
+UCLASS()
+class TPSTEMPLATE_API UHitReactionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Reserve a simulated body for BoneName of Hurtbox
+	 * On Started the caller sets the body up; the subsystem calls Hurtbox->EndBoneReaction once it recovered.
+	 * Merged reactions last Duration from now, but no longer than MaxDuration after they started.
+	 */
+	EHitReactionRequest RequestReaction(UHurtbox* Hurtbox, FName BoneName, const FVector& HitLocation, float Duration, float MaxDuration);
+
+	/** End every active reaction of Hurtbox now */
+	void ReleaseAll(UHurtbox* Hurtbox);
+
+	int32 GetNumActiveReactions() const { return Budget.Reactions.Num(); }
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Distance LOD against the local player's camera */
+	bool IsWithinReactionRange(const UHurtbox* Hurtbox, const FVector& HitLocation) const;
+
+	/** End and remove Budget.Reactions[Index] */
+	void EndReactionAt(int32 Index);
+
+	FHitReactionBudget Budget;
+};
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "HitscanSubsystem.generated.h"
+
+class AMasterWeapon;
+
+/**
+ * Batches hitscan line traces through the async trace queue
+ *
+ * A shot queues its aim trace; the next frame all finished aim traces are handed back to their weapons in one pass,
+ * and the pellets the weapons queue from there (a whole shotgun burst is one entry) resolve the frame after that.
+ * Nothing here blocks the game thread on a physics query.
+ *
+ * tps.Weapon.HitscanBenchmark [Weapons] [Pellets] [Frames] compares the game-thread cost of that against the old
+ * synchronous pipeline (camera trace, muzzle trace and one trace per pellet) for N weapons firing every frame.
+ */
+UCLASS()
+class TPSTEMPLATE_API UHitscanSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Queue the camera/aim trace of a shot; the weapon gets OnAimTraceComplete next frame */
+	void QueueAimTrace(AMasterWeapon* Weapon, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Queue every pellet of a shot as one batch; the weapon gets OnPelletTracesComplete next frame */
+	void QueuePelletTraces(AMasterWeapon* Weapon, const FVector& Start, TConstArrayView<FVector> Ends, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Fire NumWeapons shots of NumPellets from the player camera every frame for NumFrames frames, sync and async */
+	void RunBenchmark(int32 NumWeapons, int32 NumPellets, int32 NumFrames);
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EStage : uint8
+	{
+		Aim,
+		Pellets
+	};
+
+	struct FPendingShot
+	{
+		TWeakObjectPtr<AMasterWeapon> Weapon;
+		EStage Stage = EStage::Aim;
+		FVector Start = FVector::ZeroVector;
+		TArray<FVector, TInlineAllocator<8>> Ends;
+		TArray<FTraceHandle, TInlineAllocator<8>> Handles;
+
+		/** Async results are readable the frame after submission */
+		uint64 SubmitFrame = 0;
+	};
+
+	void QueueTraces(AMasterWeapon* Weapon, EStage Stage, const FVector& Start, TConstArrayView<FVector> Ends, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Result of a single-hit async trace (an empty hit ending at End on a miss or an expired handle) */
+	FHitResult ReadTrace(const FTraceHandle& Handle, const FVector& Start, const FVector& End) const;
+
+	/** One benchmark frame: time both pipelines on the same shot directions */
+	void TickBenchmark();
+
+	TArray<FPendingShot> PendingShots;
+
+	int32 BenchmarkWeapons = 0;
+	int32 BenchmarkPellets = 0;
+	int32 BenchmarkFramesRemaining = 0;
+	int32 BenchmarkFrames = 0;
+	double BenchmarkSyncTime = 0.0;
+	double BenchmarkAsyncTime = 0.0;
+
+	/** Async traces queued by the previous benchmark frame, read back this frame */
+	TArray<FTraceHandle> BenchmarkHandles;
+	TArray<FVector> BenchmarkEnds;
+	FVector BenchmarkStart = FVector::ZeroVector;
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "InventorySaveSubsystem.generated.h"
+
+class ATPSTemplateCharacter;
+struct FInventorySaveData;
+
+DECLARE_DELEGATE_OneParam(FOnInventoryLoadComplete, bool /*bSuccess*/);
+
+/**
+ * Saves/loads a character's inventory and equipment as a compact FInventorySaveData file
+ * (Saved/SaveGames/<Slot>.inv) instead of a reflected USaveGame
+ *
+ * Snapshots are built and applied on the game thread; file IO and (de)serialization run on the thread pool,
+ * and item assets are streamed in through the asset manager before the snapshot is applied.
+ */
+UCLASS()
+class TPSTEMPLATE_API UInventorySaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Snapshot the character now and write it in the background; returns false if the snapshot could not be built */
+	bool SaveCharacter(ATPSTemplateCharacter* Character, const FString& SlotName);
+
+	/** Read, parse and stream in a saved slot, then apply it to the character; OnComplete runs on the game thread */
+	void LoadCharacterAsync(ATPSTemplateCharacter* Character, const FString& SlotName, FOnInventoryLoadComplete OnComplete);
+
+	bool DoesSaveExist(const FString& SlotName) const;
+
+	static FString GetSaveFilePath(const FString& SlotName);
+
+private:
+	void ApplyLoadedData(TWeakObjectPtr<ATPSTemplateCharacter> WeakCharacter, TSharedRef<FInventorySaveData> Data, FOnInventoryLoadComplete OnComplete);
+};
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NoiseEventSubsystem.generated.h"
+
+/**
+ * Funnels gameplay noise into the AI hearing sense
+ *
+ * Noise from the same instigator (and tag) is coalesced per tps.AI.NoiseWindow: the first event goes out at once, later
+ * ones within the window merge into a single event (latest location, loudest loudness) sent when the window closes.
+ * Every controller whose perception has a hearing sense config is a listener (found by walking the world's controllers,
+ * so no AI needs to register); listeners are kept in a uniform grid, and an event is only handed to UAISense_Hearing
+ * when at least one listener has it within HearingRange - a full-auto burst far from every enemy costs nothing.
+ */
+UCLASS()
+class TPSTEMPLATE_API UNoiseEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Same parameters as UAISense_Hearing::ReportNoiseEvent */
+	void ReportNoise(AActor* Instigator, const FVector& Location, float Loudness = 1.f, float MaxRange = 0.f, FName Tag = NAME_None);
+
+	//==============================================================================
+	// UTickableWorldSubsystem
+	//==============================================================================
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FNoiseChannel
+	{
+		TWeakObjectPtr<AActor> Instigator;
+		FName Tag;
+		double WindowEnd = 0.0;
+
+		/** Merged event waiting for WindowEnd */
+		bool bPending = false;
+		FVector Location = FVector::ZeroVector;
+		float Loudness = 0.f;
+		float MaxRange = 0.f;
+	};
+
+	struct FListener
+	{
+		FVector Location = FVector::ZeroVector;
+		float HearingRange = 0.f;
+	};
+
+	/** Forward to the hearing sense if any listener can hear it */
+	void EmitNoise(AActor* Instigator, const FVector& Location, float Loudness, float MaxRange, FName Tag);
+
+	bool IsAudible(const FVector& Location, float Loudness, float MaxRange);
+
+	/** Collect hearing listeners and re-bin their pawns; positions are at most GridRefreshInterval old */
+	void RefreshGrid();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TArray<FNoiseChannel> Channels;
+	TArray<FListener> Listeners;
+
+	/** Cell -> indices into Listeners */
+	TMap<FIntPoint, TArray<int32>> Grid;
+	float CellSize = 2000.f;
+	float MaxHearingRange = 0.f;
+	double LastGridRefreshTime = -1.0;
+};
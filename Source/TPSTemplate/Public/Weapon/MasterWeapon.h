@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Equipments/EquipmentBase.h"
 #include "Library/AnimationState.h"
+#include "Weapon/WeaponSpread.h"
 #include "MasterWeapon.generated.h"
 
 class AInteraction;
@@ -14,6 +15,38 @@ class ATPSTemplateCharacter;
 class APlayer_Base;
 class AIWeaponPickup;
 
+/**
+ * Per-shot state resolved once when the trigger is pulled and passed through the whole fire pipeline
+ * (FX, aim trace, pellets, tracers), so the muzzle socket and camera are only queried once per shot
+ */
+struct FWeaponFireContext
+{
+	/** Muzzle socket in world space at the moment of firing */
+	FTransform MuzzleTransform;
+
+	/** Player camera manager basis (spread offsets, blank tracer direction) */
+	FVector ViewLocation = FVector::ZeroVector;
+	FVector ViewForward = FVector::ForwardVector;
+	FVector ViewRight = FVector::RightVector;
+	FVector ViewUp = FVector::UpVector;
+
+	/** Aim ray from the owner's camera component */
+	bool bHasAimCamera = false;
+	FVector AimStart = FVector::ZeroVector;
+	FVector AimEnd = FVector::ZeroVector;
+
+	/** Aim trace ignores the weapon; bullets also ignore the owner */
+	FCollisionQueryParams AimQueryParams;
+	FCollisionQueryParams BulletQueryParams;
+
+	APlayerController* PlayerController = nullptr;
+
+	/** Consecutive shot number (recoil pattern index) */
+	int32 ShotIndex = 0;
+
+	FVector GetMuzzleLocation() const { return MuzzleTransform.GetLocation(); }
+};
+
 UCLASS()
 class TPSTEMPLATE_API AMasterWeapon : public AEquipmentBase
 {
@@ -29,6 +62,27 @@ public:
 	// Hit 처리 함수
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	bool ApplyHit(const FHitResult HitResult, bool& ValidHit);
+
+	/** Deal Damage to the victim of HitResult through IDamageable; returns the damage actually taken */
+	float ApplyDamage(const FHitResult& HitResult, float Damage);
+
+	/** Hit marker and kill confirmation for the hits of a frame (UDamageAggregatorSubsystem) */
+	void PlayHitFeedback(bool bValidHit, bool bKilled);
+
+	/** Aim trace of a shot resolved (UHitscanSubsystem) - queues the pellets, or a blank tracer on a miss */
+	void OnAimTraceComplete(const FHitResult& AimHit);
+
+	/** All pellets of a shot resolved (UHitscanSubsystem) */
+	void OnPelletTracesComplete(const FVector& MuzzleLocation, TConstArrayView<FHitResult> PelletHits);
+
+	/** Restart the spread sequence from Seed (replays, netcode, tests) */
+	void SetSpreadSeed(int32 Seed) { Spread.Initialize(Seed); }
+
+	/** A simulated projectile fired from Origin hit something (UBallisticsSubsystem) */
+	void OnProjectileImpact(const FHitResult& HitResult, const FVector& Origin);
+
+	/** Time NumShots of the per-shot hot path (context, spread, logs) against the old LogTemp logging, without firing (tps.Weapon.FireBenchmark) */
+	void RunFireBenchmark(int32 NumShots);
 	
 protected:
 	// Called when the game starts or when spawned
@@ -70,14 +124,31 @@ private:
 
 	// Fire helper functions
 	void ApplyCameraShake(APlayerController* PC);
-	bool PerformCameraTrace(APlayerCameraManager* CameraManager, FHitResult& OutHitResult);
-	void ExecuteFireSequence(const FHitResult& CameraHitResult);
+	/** Resolve the muzzle transform, view basis and trace params for a shot; false without an owner or camera */
+	bool BuildFireContext(APlayerController* PC, FWeaponFireContext& OutContext) const;
+
+	/** Queue the aim trace from the owner's camera; false if there is nothing to aim with */
+	bool PerformCameraTrace(const FWeaponFireContext& Context);
+
+	/** Queue one trace per burst pellet from the muzzle towards the spread-adjusted aim point */
+	void FireBullet(const FWeaponFireContext& Context, const FHitResult& Hit);
+
+	void ProcessBulletHit(const FHitResult& HitResult, const FVector& MuzzleLocation);
+
+	void FireFX(const FWeaponFireContext& Context);
+
+	void FireBlankTracer(const FWeaponFireContext& Context);
 
-	void FireBullet(FHitResult Hit, bool bReturnHit);
+	/** Take a tracer from the world actor pool (falls back to SpawnActor when there is no pool) */
+	AActor* SpawnTracer(const FTransform& SpawnTransform);
 
-	void FireFX();
+	/** Seeded spread/recoil source for this weapon */
+	FWeaponSpreadGenerator Spread;
 
-	void FireBlankTracer();
+	/** Recoil pattern progress */
+	int32 ConsecutiveShots = 0;
+	double LastShotTime = -1.0;
 
-	void RandPointInCircle(float Radius, float& PointX, float& PointY);
+	/** Contexts of shots whose aim trace is still in flight, oldest first */
+	TArray<FWeaponFireContext, TInlineAllocator<2>> PendingFireContexts;
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-step fire-rate scheduler
+ * Tracks the time until the next shot with sub-frame precision, so over any span of held trigger the number of
+ * shots is span / interval regardless of frame rate (a timer re-armed each shot loses up to a frame per shot).
+ * Pure and deterministic: the same sequence of Advance calls always produces the same shot counts.
+ */
+struct FWeaponFireScheduler
+{
+	/** Shots released in a single step at most; a long hitch drops the rest instead of firing a burst */
+	static constexpr int32 MaxShotsPerStep = 8;
+
+	/** Seconds between shots (UWeaponData::FireRate) */
+	void SetShotInterval(float InShotInterval)
+	{
+		ShotInterval = FMath::Max(static_cast<double>(InShotInterval), UE_KINDA_SMALL_NUMBER);
+	}
+
+	/** Shots a single press may fire: 1 for semi-auto, the burst size for burst, 0 for no limit (full-auto) */
+	void SetShotsPerPress(int32 InShotsPerPress)
+	{
+		ShotsPerPress = FMath::Max(InShotsPerPress, 0);
+	}
+
+	/**
+	 * Advance the clock by DeltaTime and return how many shots are due in this step
+	 * Fractional time left over after the last shot carries into the next step; releasing the trigger
+	 * lets the cooldown run out but does not bank shots for the next press.
+	 * bCanShoot holds fire without ending the press, so a semi-auto press blocked for a frame does not refire.
+	 */
+	int32 Advance(float DeltaTime, bool bTriggerHeld, bool bCanShoot = true)
+	{
+		Cooldown -= DeltaTime;
+		if (!bTriggerHeld)
+		{
+			bPressActive = false;
+			Cooldown = FMath::Max(Cooldown, 0.0);
+			return 0;
+		}
+
+		if (!bPressActive)
+		{
+			bPressActive = true;
+			ShotsThisPress = 0;
+		}
+
+		int32 Shots = 0;
+		while (bCanShoot && Cooldown <= 0.0 && Shots < MaxShotsPerStep
+			&& (ShotsPerPress == 0 || ShotsThisPress < ShotsPerPress))
+		{
+			++Shots;
+			++ShotsThisPress;
+			Cooldown += ShotInterval;
+		}
+
+		// Hitch longer than MaxShotsPerStep intervals: the missing shots are not owed
+		Cooldown = FMath::Max(Cooldown, 0.0);
+		return Shots;
+	}
+
+	/** Allow the next press to fire immediately */
+	void Reset()
+	{
+		Cooldown = 0.0;
+		bPressActive = false;
+		ShotsThisPress = 0;
+	}
+
+	/** Seconds until the next shot can fire */
+	double GetCooldown() const { return Cooldown; }
+
+private:
+	double Cooldown = 0.0;
+	double ShotInterval = 0.1;
+	int32 ShotsPerPress = 0;
+	int32 ShotsThisPress = 0;
+	bool bPressActive = false;
+};
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+class UCurveVector;
+
+/**
+ * Seeded, table-driven bullet spread for one weapon
+ *
+ * Offsets come from a shared table of points spread uniformly over the unit disk (built once, fixed seed), picked
+ * by the weapon's own FRandomStream: one integer draw and a multiply per pellet, no trig. The same seed always
+ * produces the same sequence, so a shot can be reproduced for replays, netcode or tests.
+ */
+struct TPSTEMPLATE_API FWeaponSpreadGenerator
+{
+	/** Samples in the shared unit-disk table */
+	static constexpr int32 DiskTableSize = 256;
+
+	/** Restart the sequence from Seed */
+	void Initialize(int32 Seed);
+
+	int32 GetSeed() const { return Stream.GetInitialSeed(); }
+
+	/** Next spread offset, uniformly distributed over a disk of Radius */
+	FVector2D SampleDisk(float Radius);
+
+	/** Recoil offset for the ShotIndex-th consecutive shot (curve X/Y, time = shot index); zero without a curve */
+	static FVector2D GetRecoilOffset(const UCurveVector* RecoilPattern, int32 ShotIndex);
+
+private:
+	/** Points uniform over the unit disk (one per equal-area ring, radius = sqrt of the ring's area fraction) */
+	static const TArray<FVector2f>& GetUnitDiskTable();
+
+	FRandomStream Stream;
+};
@@ -2,6 +2,31 @@
 
 #include "TPSTemplate.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/IConsoleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TPSTemplate, "TPSTemplate" );
- 
\ No newline at end of file
+
+DEFINE_LOG_CATEGORY(LogTPSWeapon);
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	bool bWeaponDebug = false;
+
+	FAutoConsoleVariableRef CVarWeaponDebug(
+		TEXT("tps.Weapon.Debug"),
+		bWeaponDebug,
+		TEXT("Show per-shot weapon logs (LogTPSWeapon Verbose) and on-screen weapon debug messages."),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Variable)
+		{
+			LogTPSWeapon.SetVerbosity(Variable->GetBool() ? ELogVerbosity::Verbose : ELogVerbosity::Log);
+		}),
+		ECVF_Cheat
+	);
+}
+
+bool IsWeaponDebugEnabled()
+{
+	return bWeaponDebug;
+}
+#endif
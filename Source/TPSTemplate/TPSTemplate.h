@@ -3,3 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/** Stat group for the game module's runtime systems (stat TPSTemplate) */
+DECLARE_STATS_GROUP(TEXT("TPSTemplate"), STATGROUP_TPSTemplate, STATCAT_Advanced);
+
+/** Weapon/fire pipeline log; per-shot traces are Verbose and compiled out of Shipping */
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogTPSWeapon, Warning, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogTPSWeapon, Log, All);
+#endif
+
+/** tps.Weapon.Debug: per-shot logs and on-screen weapon debug messages (always off in Shipping) */
+#if UE_BUILD_SHIPPING
+inline bool IsWeaponDebugEnabled() { return false; }
+#else
+TPSTEMPLATE_API bool IsWeaponDebugEnabled();
+#endif